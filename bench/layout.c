@@ -0,0 +1,248 @@
+// Layout microbenchmark.
+//
+// Times hikari_split_layout for every container layout and a set of random
+// split trees with 1 to MAX_VIEWS views. Layouts are computed without a split
+// cache so every iteration does the full work.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <hikari/log.h>
+#include <hikari/memory.h>
+#include <hikari/sheet_layout.h>
+#include <hikari/split.h>
+
+#define MAX_VIEWS 512
+#define NR_OF_RANDOM_SPLITS 8
+#define TILES_PER_SAMPLE (1 << 20)
+
+enum hikari_log_level hikari_log_level = HIKARI_LOG_INFO;
+
+const char *hikari_log_level_names[] = {
+  [HIKARI_LOG_ERROR] = "ERROR",
+  [HIKARI_LOG_WARN] = "WARN",
+  [HIKARI_LOG_INFO] = "INFO",
+  [HIKARI_LOG_DEBUG] = "DEBUG",
+  [HIKARI_LOG_TRACE] = "TRACE",
+};
+
+struct layout {
+  const char *name;
+  hikari_layout_func func;
+  int max;
+};
+
+static const struct layout layouts[] = {
+  { "queue", hikari_sheet_queue_layout, MAX_VIEWS },
+  { "stack", hikari_sheet_stack_layout, MAX_VIEWS },
+  { "full", hikari_sheet_full_layout, MAX_VIEWS },
+  { "grid", hikari_sheet_grid_layout, MAX_VIEWS },
+  { "single", hikari_sheet_single_layout, 1 },
+  { "empty", hikari_sheet_empty_layout, 0 },
+};
+
+static const int nr_of_layouts = sizeof(layouts) / sizeof(layouts[0]);
+
+static uint64_t rng_state;
+
+static uint32_t
+rng(void)
+{
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  return rng_state >> 32;
+}
+
+static uint64_t
+now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static struct hikari_split *
+container(const struct layout *layout)
+{
+  struct hikari_split_container *container = hikari_tagged_malloc(
+      HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_container));
+
+  hikari_split_container_init(container, layout->max, layout->func);
+
+  return &container->split;
+}
+
+static void
+random_scale(struct hikari_split_scale *scale)
+{
+  if (rng() % 2) {
+    scale->type = HIKARI_SPLIT_SCALE_TYPE_FIXED;
+    scale->scale.fixed = 0.1 + (rng() % 81) / 100.0;
+  } else {
+    scale->type = HIKARI_SPLIT_SCALE_TYPE_DYNAMIC;
+    scale->scale.dynamic.min = hikari_split_scale_min;
+    scale->scale.dynamic.max = hikari_split_scale_max;
+  }
+}
+
+static struct hikari_split *
+random_split(int depth)
+{
+  if (depth == 0 || rng() % 4 == 0) {
+    struct layout layout = layouts[rng() % nr_of_layouts];
+    if (layout.max > 1) {
+      layout.max = 2 + rng() % 255;
+    }
+    return container(&layout);
+  }
+
+  struct hikari_split_scale scale;
+  random_scale(&scale);
+
+  struct hikari_split *first = random_split(depth - 1);
+  struct hikari_split *second = random_split(depth - 1);
+
+  if (rng() % 2) {
+    struct hikari_split_vertical *split = hikari_tagged_malloc(
+        HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_vertical));
+
+    hikari_split_vertical_init(split,
+        &scale,
+        rng() % 2 ? HIKARI_VERTICAL_SPLIT_ORIENTATION_LEFT
+                  : HIKARI_VERTICAL_SPLIT_ORIENTATION_RIGHT,
+        first,
+        second);
+
+    return &split->split;
+  } else {
+    struct hikari_split_horizontal *split = hikari_tagged_malloc(
+        HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_horizontal));
+
+    hikari_split_horizontal_init(split,
+        &scale,
+        rng() % 2 ? HIKARI_HORIZONTAL_SPLIT_ORIENTATION_TOP
+                  : HIKARI_HORIZONTAL_SPLIT_ORIENTATION_BOTTOM,
+        first,
+        second);
+
+    return &split->split;
+  }
+}
+
+struct result {
+  uint64_t ns;
+  uint64_t layouts;
+  uint64_t tiles;
+};
+
+static uint64_t checksum;
+
+static void
+bench_split(const char *name, struct hikari_split *split)
+{
+  static const int gap = 5;
+  static const int border = 1;
+  struct wlr_box frame = { .x = 0, .y = 0, .width = 3840, .height = 2160 };
+
+  int nr_of_containers = hikari_split_nr_of_containers(split);
+  int *capacities = hikari_malloc(nr_of_containers * sizeof(int));
+  int *counts = hikari_malloc(nr_of_containers * sizeof(int));
+  struct wlr_box *view_geometries =
+      hikari_malloc(MAX_VIEWS * sizeof(struct wlr_box));
+  struct wlr_box *tiles = hikari_malloc(MAX_VIEWS * sizeof(struct wlr_box));
+  struct result total = { 0 };
+
+  hikari_split_capacities(split, capacities);
+
+  for (int i = 0; i < MAX_VIEWS; i++) {
+    view_geometries[i] = (struct wlr_box){ .x = rng() % frame.width,
+      .y = rng() % frame.height,
+      .width = 100 + rng() % 1000,
+      .height = 100 + rng() % 1000 };
+  }
+
+  for (int nr_of_views = 1; nr_of_views <= MAX_VIEWS; nr_of_views++) {
+    int remaining = nr_of_views;
+    for (int i = 0; i < nr_of_containers; i++) {
+      counts[i] = remaining < capacities[i] ? remaining : capacities[i];
+      remaining -= counts[i];
+    }
+
+    int rounds = TILES_PER_SAMPLE / nr_of_views / 16;
+    if (rounds < 16) {
+      rounds = 16;
+    }
+
+    int nr_of_tiles = 0;
+    uint64_t start = now();
+    for (int round = 0; round < rounds; round++) {
+      nr_of_tiles = hikari_split_layout(
+          split, NULL, &frame, counts, view_geometries, gap, border, tiles);
+      if (nr_of_tiles > 0) {
+        checksum += tiles[round % nr_of_tiles].width;
+      }
+    }
+    uint64_t ns = now() - start;
+
+    total.ns += ns;
+    total.layouts += rounds;
+    total.tiles += (uint64_t)rounds * nr_of_tiles;
+
+    if ((nr_of_views & (nr_of_views - 1)) == 0) {
+      printf("%-10s %5d %6d %12.1f %10.2f\n",
+          name,
+          nr_of_views,
+          nr_of_tiles,
+          (double)ns / rounds,
+          nr_of_tiles > 0 ? (double)ns / rounds / nr_of_tiles : 0.0);
+    }
+  }
+
+  printf("%-10s %5s %6s %12.1f %10.2f\n\n",
+      name,
+      "all",
+      "-",
+      (double)total.ns / total.layouts,
+      total.tiles > 0 ? (double)total.ns / total.tiles : 0.0);
+
+  hikari_free(capacities);
+  hikari_free(counts);
+  hikari_free(view_geometries);
+  hikari_free(tiles);
+}
+
+int
+main(int argc, char **argv)
+{
+  uint64_t seed = argc > 1 ? strtoull(argv[1], NULL, 10) : 1;
+  rng_state = seed != 0 ? seed : 1;
+
+  printf("%-10s %5s %6s %12s %10s\n",
+      "layout",
+      "views",
+      "tiles",
+      "ns/layout",
+      "ns/tile");
+
+  for (int i = 0; i < nr_of_layouts; i++) {
+    struct hikari_split *split = container(&layouts[i]);
+    bench_split(layouts[i].name, split);
+    hikari_split_free(split);
+  }
+
+  for (int i = 0; i < NR_OF_RANDOM_SPLITS; i++) {
+    char name[16];
+    snprintf(name, sizeof(name), "random-%d", i);
+
+    struct hikari_split *split = random_split(4);
+    bench_split(name, split);
+    hikari_split_free(split);
+  }
+
+  fprintf(stderr, "checksum %llu\n", (unsigned long long)checksum);
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#if !defined(HIKARI_BENCH_WLR_UTIL_BOX_H)
+#define HIKARI_BENCH_WLR_UTIL_BOX_H
+
+// Minimal stand-in for <wlr/util/box.h> so the layout code can be built
+// without wlroots.
+
+#include <stdbool.h>
+
+struct wlr_box {
+  int x, y;
+  int width, height;
+};
+
+static inline bool
+wlr_box_equal(const struct wlr_box *a, const struct wlr_box *b)
+{
+  return a->x == b->x && a->y == b->y && a->width == b->width &&
+         a->height == b->height;
+}
+
+#endif
@@ -1,6 +1,16 @@
 #if !defined(HIKARI_COMMAND_H)
 #define HIKARI_COMMAND_H
 
+#include <stdbool.h>
+
+struct wl_event_loop;
+
+bool
+hikari_command_init(struct wl_event_loop *event_loop);
+
+void
+hikari_command_fini(void);
+
 void
 hikari_command_execute(const char *cmd);
 
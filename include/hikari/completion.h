@@ -1,26 +1,43 @@
 #if !defined(HIKARI_COMPLETION_H)
 #define HIKARI_COMPLETION_H
 
-#include <wayland-util.h>
-
-struct hikari_completion_item {
-  char data[256];
-  struct wl_list completion_items;
+// A completion index keeps names sorted so that all names starting with a
+// given prefix form a contiguous range that can be found by binary search.
+// Names are not copied, they have to outlive their entry in the index.
+
+struct hikari_completion_index {
+  char **names;
+  int nr_of_names;
+  int capacity;
 };
 
 struct hikari_completion {
-  struct hikari_completion_item *current_item;
-  struct wl_list items;
+  struct hikari_completion_index *index;
+  char data[256];
+  int current;
 };
 
 void
-hikari_completion_init(struct hikari_completion *completion, char *data);
+hikari_completion_index_init(struct hikari_completion_index *index);
 
 void
-hikari_completion_fini(struct hikari_completion *completion);
+hikari_completion_index_fini(struct hikari_completion_index *index);
+
+void
+hikari_completion_index_insert(
+    struct hikari_completion_index *index, char *name);
 
 void
-hikari_completion_add(struct hikari_completion *completion, char *data);
+hikari_completion_index_remove(
+    struct hikari_completion_index *index, char *name);
+
+void
+hikari_completion_init(struct hikari_completion *completion,
+    struct hikari_completion_index *index,
+    char *data);
+
+void
+hikari_completion_fini(struct hikari_completion *completion);
 
 char *
 hikari_completion_cancel(struct hikari_completion *completion);
@@ -7,7 +7,9 @@
 
 #include <hikari/exec.h>
 #include <hikari/font.h>
+#include <hikari/hash_map.h>
 #include <hikari/mark.h>
+#include <hikari/view_matcher.h>
 
 struct hikari_group;
 struct hikari_binding;
@@ -15,6 +17,19 @@ struct hikari_sheet;
 struct hikari_view;
 struct hikari_pointer_config;
 
+enum hikari_configuration_section {
+  HIKARI_CONFIGURATION_SECTION_UI,
+  HIKARI_CONFIGURATION_SECTION_OUTPUTS,
+  HIKARI_CONFIGURATION_SECTION_INPUTS,
+  HIKARI_CONFIGURATION_SECTION_SWITCHES,
+  HIKARI_CONFIGURATION_SECTION_BINDINGS,
+  HIKARI_CONFIGURATION_SECTION_LAYOUTS,
+  HIKARI_CONFIGURATION_SECTION_VIEWS,
+  HIKARI_CONFIGURATION_SECTION_ACTIONS,
+  HIKARI_CONFIGURATION_SECTION_MARKS,
+  HIKARI_NR_OF_CONFIGURATION_SECTIONS
+};
+
 struct hikari_configuration {
   float clear[4];
   float foreground[4];
@@ -31,10 +46,15 @@ struct hikari_configuration {
   int border;
   int gap;
   int step;
+  int layout_timeout;
+
+  bool xwayland_lazy;
+  int xwayland_idle_timeout;
 
   struct hikari_exec execs[HIKARI_NR_OF_EXECS];
 
   struct wl_list view_configs;
+  struct hikari_view_matcher view_matcher;
   struct wl_list output_configs;
   struct wl_list pointer_configs;
   struct wl_list keyboard_configs;
@@ -43,6 +63,13 @@ struct hikari_configuration {
   struct wl_list keyboard_binding_configs;
   struct wl_list mouse_binding_configs;
   struct wl_list switch_configs;
+
+  struct hikari_hash_map output_configs_by_name;
+  struct hikari_hash_map pointer_configs_by_name;
+  struct hikari_hash_map keyboard_configs_by_name;
+  struct hikari_hash_map switch_configs_by_name;
+
+  uint64_t fingerprints[HIKARI_NR_OF_CONFIGURATION_SECTIONS];
 };
 
 extern struct hikari_configuration *hikari_configuration;
@@ -58,7 +85,20 @@ hikari_configuration_load(
     struct hikari_configuration *configuration, char *config_path);
 
 bool
-hikari_configuration_reload(char *config_path);
+hikari_configuration_parse(struct hikari_configuration *configuration,
+    char *config_path,
+    char **environment);
+
+void
+hikari_configuration_apply(struct hikari_configuration *configuration);
+
+bool
+hikari_configuration_compile_keymaps(
+    struct hikari_configuration *configuration);
+
+bool
+hikari_configuration_build_keymaps(
+    struct hikari_configuration *configuration);
 
 struct hikari_view_config *
 hikari_configuration_resolve_view_config(
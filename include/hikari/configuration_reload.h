@@ -0,0 +1,17 @@
+#if !defined(HIKARI_CONFIGURATION_RELOAD_H)
+#define HIKARI_CONFIGURATION_RELOAD_H
+
+#include <stdbool.h>
+
+#include <wayland-server-core.h>
+
+bool
+hikari_configuration_reload_init(struct wl_event_loop *event_loop);
+
+void
+hikari_configuration_reload_fini(void);
+
+void
+hikari_configuration_reload(char *config_path);
+
+#endif
@@ -5,8 +5,11 @@
 
 #include <wlr/types/wlr_xdg_decoration_v1.h>
 
+struct hikari_xdg_view;
+
 struct hikari_decoration {
   struct wlr_xdg_toplevel_decoration_v1 *decoration;
+  struct hikari_xdg_view *xdg_view;
 
   struct wl_listener request_mode;
   struct wl_listener destroy;
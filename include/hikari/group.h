@@ -5,6 +5,8 @@
 
 #include <wayland-util.h>
 
+#include <hikari/hash_map.h>
+
 struct hikari_sheet;
 struct hikari_view;
 struct hikari_workspace;
@@ -17,6 +19,8 @@ struct hikari_group {
 
   struct wl_list server_groups;
   struct wl_list visible_server_groups;
+
+  struct hikari_hash_map_entry name_entry;
 };
 
 void
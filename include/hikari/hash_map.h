@@ -0,0 +1,47 @@
+#if !defined(HIKARI_HASH_MAP_H)
+#define HIKARI_HASH_MAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// String keyed hash map of intrusive entries, use wl_container_of to get to
+// the structure embedding an entry. Keys are not copied and need to outlive
+// their entries. Entries with equal keys shadow each other, the one inserted
+// last is found first.
+
+struct hikari_hash_map_entry {
+  struct hikari_hash_map_entry *next;
+
+  const char *key;
+  uint32_t hash;
+};
+
+struct hikari_hash_map {
+  struct hikari_hash_map_entry **buckets;
+
+  size_t nr_of_buckets;
+  size_t nr_of_entries;
+};
+
+uint32_t
+hikari_hash_string(const char *str);
+
+void
+hikari_hash_map_init(struct hikari_hash_map *map);
+
+void
+hikari_hash_map_fini(struct hikari_hash_map *map);
+
+void
+hikari_hash_map_insert(struct hikari_hash_map *map,
+    struct hikari_hash_map_entry *entry,
+    const char *key);
+
+void
+hikari_hash_map_remove(
+    struct hikari_hash_map *map, struct hikari_hash_map_entry *entry);
+
+struct hikari_hash_map_entry *
+hikari_hash_map_lookup(struct hikari_hash_map *map, const char *key);
+
+#endif
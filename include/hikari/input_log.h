@@ -0,0 +1,40 @@
+#if !defined(HIKARI_INPUT_LOG_H)
+#define HIKARI_INPUT_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct wlr_keyboard_key_event;
+struct wlr_pointer_button_event;
+struct wlr_pointer_axis_event;
+struct wlr_switch_toggle_event;
+
+bool
+hikari_input_log_record(const char *path);
+
+bool
+hikari_input_log_replay(const char *path);
+
+void
+hikari_input_log_start(void);
+
+void
+hikari_input_log_fini(void);
+
+void
+hikari_input_log_key(struct wlr_keyboard_key_event *event);
+
+void
+hikari_input_log_motion(double x, double y);
+
+void
+hikari_input_log_button(struct wlr_pointer_button_event *event);
+
+void
+hikari_input_log_axis(struct wlr_pointer_axis_event *event);
+
+void
+hikari_input_log_switch(
+    const char *name, struct wlr_switch_toggle_event *event);
+
+#endif
@@ -8,9 +8,10 @@
 #include <wlr/types/wlr_input_device.h>
 #include <wlr/types/wlr_keyboard.h>
 
-#include <hikari/binding_group.h>
 #include <hikari/keyboard_config.h>
 
+struct hikari_keymap;
+
 struct hikari_keyboard {
   struct wl_list server_keyboards;
   struct wlr_input_device *device;
@@ -20,11 +21,9 @@ struct hikari_keyboard {
   struct wl_listener key;
   struct wl_listener destroy;
 
-  struct xkb_keymap *keymap;
+  struct hikari_keymap *keymap;
 
   bool is_virtual;
-
-  struct hikari_binding_group bindings[HIKARI_BINDING_GROUP_MASK];
 };
 
 void
@@ -36,11 +35,8 @@ hikari_keyboard_fini(struct hikari_keyboard *keyboard);
 
 void
 hikari_keyboard_configure(struct hikari_keyboard *keyboard,
-    struct hikari_keyboard_config *keyboard_config);
-
-void
-hikari_keyboard_configure_bindings(
-    struct hikari_keyboard *keyboard, struct wl_list *bindings);
+    struct hikari_keyboard_config *keyboard_config,
+    struct wl_list *bindings);
 
 typedef void (*hikari_keysym_iterator)(
     struct hikari_keyboard *keyboard, uint32_t keycode, xkb_keysym_t sym);
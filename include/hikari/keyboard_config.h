@@ -6,6 +6,7 @@
 #include <wayland-util.h>
 #include <xkbcommon/xkbcommon.h>
 
+#include <hikari/hash_map.h>
 #include <hikari/option.h>
 
 struct hikari_xkb_config {
@@ -14,6 +15,10 @@ struct hikari_xkb_config {
   HIKARI_OPTION(layout, char *);
   HIKARI_OPTION(variant, char *);
   HIKARI_OPTION(options, char *);
+
+  // compiled off the event loop, handed to the keymap cache once the
+  // configuration is applied
+  struct xkb_keymap *keymap;
 };
 
 HIKARI_OPTION_FUNS(xkb, rules, char *);
@@ -37,6 +42,7 @@ struct hikari_keyboard_config {
   struct wl_list link;
 
   char *keyboard_name;
+  struct hikari_hash_map_entry name_entry;
 
   struct hikari_xkb xkb;
 
@@ -65,6 +71,11 @@ bool
 hikari_keyboard_config_parse(struct hikari_keyboard_config *keyboard_config,
     const ucl_object_t *keyboard_config_obj);
 
+bool
+hikari_keyboard_config_build_keymap(
+    struct hikari_keyboard_config *keyboard_config,
+    struct xkb_context *context);
+
 bool
 hikari_keyboard_config_compile_keymap(
     struct hikari_keyboard_config *keyboard_config);
@@ -0,0 +1,30 @@
+#if !defined(HIKARI_KEYMAP_H)
+#define HIKARI_KEYMAP_H
+
+#include <wayland-util.h>
+#include <xkbcommon/xkbcommon.h>
+
+#include <hikari/binding_group.h>
+
+struct hikari_keymap {
+  struct wl_list server_keymaps;
+
+  int refcount;
+
+  struct xkb_keymap *keymap;
+  struct wl_list *binding_configs;
+
+  struct hikari_binding_group bindings[HIKARI_BINDING_GROUP_MASK];
+};
+
+struct hikari_keymap *
+hikari_keymap_acquire(
+    struct xkb_keymap *xkb_keymap, struct wl_list *binding_configs);
+
+void
+hikari_keymap_release(struct hikari_keymap *keymap);
+
+void
+hikari_keymap_invalidate(struct wl_list *binding_configs);
+
+#endif
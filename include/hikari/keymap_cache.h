@@ -0,0 +1,29 @@
+#if !defined(HIKARI_KEYMAP_CACHE_H)
+#define HIKARI_KEYMAP_CACHE_H
+
+#include <wayland-util.h>
+#include <xkbcommon/xkbcommon.h>
+
+struct hikari_xkb_config;
+
+void
+hikari_keymap_cache_init(void);
+
+void
+hikari_keymap_cache_fini(void);
+
+struct xkb_keymap *
+hikari_keymap_cache_compile(struct hikari_xkb_config *xkb_config);
+
+struct xkb_keymap *
+hikari_keymap_cache_insert(
+    struct hikari_xkb_config *xkb_config, struct xkb_keymap *keymap);
+
+void
+hikari_keymap_cache_sweep(struct wl_list *keyboard_configs);
+
+struct xkb_keymap *
+hikari_keymap_cache_build(
+    struct xkb_context *context, struct hikari_xkb_config *xkb_config);
+
+#endif
@@ -0,0 +1,80 @@
+#if !defined(HIKARI_LATENCY_H)
+#define HIKARI_LATENCY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <wayland-server-core.h>
+
+struct wlr_output;
+
+enum hikari_latency_kind {
+  HIKARI_LATENCY_OTHER,
+  HIKARI_LATENCY_MOVE,
+  HIKARI_LATENCY_RESIZE,
+  HIKARI_LATENCY_FOCUS,
+  HIKARI_LATENCY_INDICATOR,
+  HIKARI_LATENCY_NR_OF_KINDS
+};
+
+#define HIKARI_LATENCY_NR_OF_SAMPLES 1024
+
+struct hikari_latency_tag {
+  uint64_t input_nsec;
+  enum hikari_latency_kind kind;
+};
+
+struct hikari_latency_samples {
+  uint32_t usec[HIKARI_LATENCY_NR_OF_SAMPLES];
+  int nsamples;
+  int next;
+  unsigned long total;
+};
+
+struct hikari_latency {
+  struct wlr_output *wlr_output;
+
+  struct hikari_latency_tag pending;
+  unsigned long pending_seq;
+  bool committed;
+
+  struct wl_listener present;
+
+  struct hikari_latency_samples samples[HIKARI_LATENCY_NR_OF_KINDS];
+};
+
+void
+hikari_latency_enable(void);
+
+void
+hikari_latency_init(
+    struct hikari_latency *latency, struct wlr_output *wlr_output);
+
+void
+hikari_latency_fini(struct hikari_latency *latency);
+
+void
+hikari_latency_input_begin(void);
+
+void
+hikari_latency_input_end(void);
+
+bool
+hikari_latency_resume(struct hikari_latency_tag *tag);
+
+void
+hikari_latency_suspend(void);
+
+void
+hikari_latency_save(struct hikari_latency_tag *tag);
+
+void
+hikari_latency_mark(enum hikari_latency_kind kind);
+
+void
+hikari_latency_damage(struct hikari_latency *latency);
+
+void
+hikari_latency_commit(struct hikari_latency *latency);
+
+#endif
@@ -26,13 +26,14 @@ hikari_maximized_state_full(struct hikari_view *view, int width, int height);
 static inline struct hikari_maximized_state *
 hikari_maximized_state_alloc(void)
 {
-  return hikari_malloc(sizeof(struct hikari_maximized_state));
+  return hikari_pool_alloc(
+      HIKARI_POOL_MAXIMIZED_STATE, sizeof(struct hikari_maximized_state));
 }
 
 static inline void
 hikari_maximized_state_destroy(struct hikari_maximized_state *maximized_state)
 {
-  hikari_free(maximized_state);
+  hikari_pool_free(HIKARI_POOL_MAXIMIZED_STATE, maximized_state);
 }
 
 #endif
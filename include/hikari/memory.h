@@ -9,7 +9,82 @@ hikari_malloc(size_t size);
 void *
 hikari_calloc(size_t number, size_t size);
 
+void *
+hikari_realloc(void *ptr, size_t size);
+
 void
 hikari_free(void *ptr);
 
+// Allocations can be tagged with the subsystem that owns them to account
+// live bytes, peak and number of allocations per subsystem. Tagged memory
+// must be released with hikari_tagged_free. Textures are not allocated by
+// hikari itself, their size is estimated from their dimensions.
+
+enum hikari_memory_tag {
+  HIKARI_MEMORY_VIEWS,
+  HIKARI_MEMORY_LAYOUTS,
+  HIKARI_MEMORY_CONFIGURATION,
+  HIKARI_MEMORY_INDICATORS,
+  HIKARI_MEMORY_BACKGROUNDS,
+  HIKARI_MEMORY_INPUT,
+  HIKARI_NR_OF_MEMORY_TAGS
+};
+
+void *
+hikari_tagged_malloc(enum hikari_memory_tag tag, size_t size);
+
+void *
+hikari_tagged_calloc(enum hikari_memory_tag tag, size_t number, size_t size);
+
+void
+hikari_tagged_free(void *ptr);
+
+void
+hikari_memory_add_texture(enum hikari_memory_tag tag, int width, int height);
+
+void
+hikari_memory_remove_texture(enum hikari_memory_tag tag, int width, int height);
+
+void
+hikari_memory_dump(void);
+
+// Objects that are created and destroyed frequently are taken from typed
+// pools. Pools carve objects out of slabs and keep freed objects on a free
+// list for reuse, slabs are only released by hikari_pools_fini.
+
+enum hikari_pool_type {
+  HIKARI_POOL_XDG_VIEW,
+  HIKARI_POOL_XWAYLAND_VIEW,
+  HIKARI_POOL_XWAYLAND_UNMANAGED_VIEW,
+  HIKARI_POOL_VIEW_SUBSURFACE,
+  HIKARI_POOL_XDG_POPUP,
+  HIKARI_POOL_LAYER_POPUP,
+  HIKARI_POOL_INPUT_POPUP,
+  HIKARI_POOL_TILE,
+  HIKARI_POOL_MAXIMIZED_STATE,
+  HIKARI_NR_OF_POOLS
+};
+
+struct hikari_pool_stats {
+  const char *name;
+  size_t object_size;
+
+  size_t live;
+  size_t peak;
+  size_t freed;
+  size_t nr_of_slabs;
+};
+
+void *
+hikari_pool_alloc(enum hikari_pool_type type, size_t size);
+
+void
+hikari_pool_free(enum hikari_pool_type type, void *ptr);
+
+void
+hikari_pool_stats(enum hikari_pool_type type, struct hikari_pool_stats *stats);
+
+void
+hikari_pools_fini(void);
+
 #endif
@@ -3,6 +3,8 @@
 
 #include <wlr/util/box.h>
 
+#include <hikari/latency.h>
+
 struct hikari_tile;
 
 enum hikari_operation_type {
@@ -22,6 +24,7 @@ struct hikari_operation {
   uint32_t serial;
   struct wlr_box geometry;
   struct hikari_tile *tile;
+  struct hikari_latency_tag latency;
 };
 
 #endif
@@ -11,6 +11,7 @@
 #include <wlr/types/wlr_damage_ring.h>
 #include <wlr/render/swapchain.h>
 
+#include <hikari/latency.h>
 #include <hikari/output_config.h>
 
 struct hikari_renderer;
@@ -22,6 +23,7 @@ struct hikari_output {
   struct hikari_workspace *workspace;
 
   bool enabled;
+  bool damage_suspended;
 
   struct wl_listener damage_frame;
   struct wl_listener destroy;
@@ -42,6 +44,8 @@ struct hikari_output {
   struct wlr_box usable_area;
 
   struct wlr_texture *background;
+
+  struct hikari_latency latency;
 };
 
 void
@@ -84,8 +88,23 @@ hikari_output_add_damage(struct hikari_output *output, struct wlr_box *region)
   assert(output != NULL);
   assert(region != NULL);
 
-  if (output->enabled) {
+  if (output->enabled && !output->damage_suspended) {
     wlr_damage_ring_add_box(&output->damage, region);
+    hikari_latency_damage(&output->latency);
+    wlr_output_schedule_frame(output->wlr_output);
+  }
+}
+
+static inline void
+hikari_output_add_damage_region(
+    struct hikari_output *output, pixman_region32_t *region)
+{
+  assert(output != NULL);
+  assert(region != NULL);
+
+  if (output->enabled && !output->damage_suspended) {
+    wlr_damage_ring_add(&output->damage, region);
+    hikari_latency_damage(&output->latency);
     wlr_output_schedule_frame(output->wlr_output);
   }
 }
@@ -112,6 +131,7 @@ hikari_output_add_effective_surface_damage(
   pixman_region32_translate(&damage, x, y);
   wlr_damage_ring_add(&output->damage, &damage);
   pixman_region32_fini(&damage);
+  hikari_latency_damage(&output->latency);
   wlr_output_schedule_frame(output->wlr_output);
 }
 
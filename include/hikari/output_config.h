@@ -5,6 +5,7 @@
 
 #include <wayland-util.h>
 
+#include <hikari/hash_map.h>
 #include <hikari/option.h>
 #include <hikari/position_config.h>
 
@@ -18,6 +19,7 @@ struct hikari_output_config {
   struct wl_list link;
 
   char *output_name;
+  struct hikari_hash_map_entry name_entry;
 
   HIKARI_OPTION(background, char *);
   HIKARI_OPTION(background_fit, enum hikari_background_fit);
@@ -6,12 +6,14 @@
 #include <libinput.h>
 #include <wayland-util.h>
 
+#include <hikari/hash_map.h>
 #include <hikari/option.h>
 
 struct hikari_pointer_config {
   struct wl_list link;
 
   char *name;
+  struct hikari_hash_map_entry name_entry;
 
   HIKARI_OPTION(accel, double);
   HIKARI_OPTION(accel_profile, enum libinput_config_accel_profile);
@@ -9,10 +9,12 @@
 #include <wlr/types/wlr_virtual_pointer_v1.h>
 #endif
 
+#include <hikari/completion.h>
 #include <hikari/configuration.h>
 #include <hikari/cursor.h>
 #include <hikari/dnd_mode.h>
 #include <hikari/group_assign_mode.h>
+#include <hikari/hash_map.h>
 #include <hikari/indicator.h>
 #include <hikari/input_grab_mode.h>
 #include <hikari/layout_select_mode.h>
@@ -38,6 +40,7 @@ struct hikari_group;
 
 struct hikari_server {
   bool cycling;
+  bool focus_deferred;
 #ifndef NDEBUG
   bool track_damage;
 #endif
@@ -46,6 +49,7 @@ struct hikari_server {
   char *config_path;
 
   struct wl_event_source *shutdown_timer;
+  struct wl_event_source *memory_dump;
 
   struct hikari_indicator indicator;
 
@@ -80,6 +84,7 @@ struct hikari_server {
   struct wl_listener new_xwayland_surface;
 
   struct wlr_xwayland *xwayland;
+  struct wlr_xwayland_server *xwayland_server;
 #endif
 
 #ifdef HAVE_VIRTUAL_INPUT
@@ -114,11 +119,14 @@ struct hikari_server {
 
   struct wl_list pointers;
   struct wl_list keyboards;
+  struct wl_list keymaps;
   struct wl_list switches;
   struct wl_list outputs;
 
   struct wl_list groups;
   struct wl_list visible_groups;
+  struct hikari_hash_map groups_by_name;
+  struct hikari_completion_index group_names;
   struct wl_list visible_views;
 
   struct hikari_mode *mode;
@@ -202,6 +210,9 @@ hikari_server_lock(void *arg);
 void
 hikari_server_reload(void *arg);
 
+void
+hikari_server_dump_memory(void *arg);
+
 void
 hikari_server_execute_command(void *arg);
 
@@ -5,6 +5,8 @@
 
 #include <wlr/util/box.h>
 
+#include <hikari/sheet_layout.h>
+
 struct hikari_group;
 struct hikari_layout;
 struct hikari_split;
@@ -13,6 +15,9 @@ struct hikari_workspace;
 struct hikari_sheet {
   uint8_t nr;
   struct wl_list views;
+  struct wl_list tileable_views;
+  int nr_of_tileable_views;
+  int nr_of_dirty_tileable_views;
   struct hikari_layout *layout;
 
   struct hikari_workspace *workspace;
@@ -39,48 +44,6 @@ hikari_sheet_prev_view(struct hikari_sheet *sheet, struct hikari_view *view);
 struct hikari_view *
 hikari_sheet_first_tileable_view(struct hikari_sheet *sheet);
 
-struct hikari_view *
-hikari_sheet_queue_layout(struct hikari_sheet *sheet,
-    struct hikari_view *first,
-    struct wlr_box *frame,
-    int max,
-    bool *center);
-
-struct hikari_view *
-hikari_sheet_stack_layout(struct hikari_sheet *sheet,
-    struct hikari_view *first,
-    struct wlr_box *frame,
-    int max,
-    bool *center);
-
-struct hikari_view *
-hikari_sheet_grid_layout(struct hikari_sheet *sheet,
-    struct hikari_view *first,
-    struct wlr_box *frame,
-    int max,
-    bool *center);
-
-struct hikari_view *
-hikari_sheet_full_layout(struct hikari_sheet *sheet,
-    struct hikari_view *first,
-    struct wlr_box *frame,
-    int max,
-    bool *center);
-
-struct hikari_view *
-hikari_sheet_single_layout(struct hikari_sheet *sheet,
-    struct hikari_view *first,
-    struct wlr_box *frame,
-    int max,
-    bool *center);
-
-struct hikari_view *
-hikari_sheet_empty_layout(struct hikari_sheet *sheet,
-    struct hikari_view *first,
-    struct wlr_box *frame,
-    int max,
-    bool *center);
-
 int
 hikari_sheet_tileable_views(struct hikari_sheet *sheet);
 
@@ -100,6 +63,10 @@ void
 hikari_sheet_apply_split(
     struct hikari_sheet *sheet, struct hikari_split *split);
 
+void
+hikari_sheet_apply_split_in_order(
+    struct hikari_sheet *sheet, struct hikari_split *split);
+
 bool
 hikari_sheet_is_visible(struct hikari_sheet *sheet);
 
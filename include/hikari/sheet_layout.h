@@ -0,0 +1,48 @@
+#if !defined(HIKARI_SHEET_LAYOUT_H)
+#define HIKARI_SHEET_LAYOUT_H
+
+#include <wlr/util/box.h>
+
+int
+hikari_sheet_queue_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles);
+
+int
+hikari_sheet_stack_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles);
+
+int
+hikari_sheet_grid_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles);
+
+int
+hikari_sheet_full_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles);
+
+int
+hikari_sheet_single_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles);
+
+int
+hikari_sheet_empty_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles);
+
+#endif
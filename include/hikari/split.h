@@ -3,12 +3,11 @@
 
 #include <wlr/util/box.h>
 
-struct hikari_renderer;
 struct hikari_sheet;
-struct hikari_view;
+struct hikari_split_cache;
 
-typedef struct hikari_view *(*hikari_layout_func)(
-    struct hikari_sheet *, struct hikari_view *, struct wlr_box *, int, bool *);
+typedef int (*hikari_layout_func)(
+    struct wlr_box *, int, int, int, struct wlr_box *);
 
 enum hikari_split_type {
   HIKARI_SPLIT_TYPE_VERTICAL,
@@ -52,6 +51,8 @@ extern const double hikari_split_scale_default;
 
 struct hikari_split {
   enum hikari_split_type type;
+
+  struct hikari_split_cache *cache;
 };
 
 struct hikari_split_vertical {
@@ -76,17 +77,30 @@ struct hikari_split_horizontal {
 
 struct hikari_split_container {
   struct hikari_split split;
-  struct wlr_box geometry;
 
   int max;
 
   hikari_layout_func layout;
 };
 
+int
+hikari_split_layout(struct hikari_split *split,
+    struct hikari_split_cache *cache,
+    struct wlr_box *frame,
+    int *counts,
+    struct wlr_box *view_geometries,
+    int gap,
+    int border,
+    struct wlr_box *tiles);
+
+struct hikari_split_cache *
+hikari_split_cache(struct hikari_split *split);
+
+int
+hikari_split_nr_of_containers(struct hikari_split *split);
+
 void
-hikari_split_apply(struct hikari_split *split,
-    struct wlr_box *geometry,
-    struct hikari_view *first);
+hikari_split_capacities(struct hikari_split *split, int *capacities);
 
 void
 hikari_split_container_init(struct hikari_split_container *container,
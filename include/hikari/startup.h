@@ -0,0 +1,20 @@
+#if !defined(HIKARI_STARTUP_H)
+#define HIKARI_STARTUP_H
+
+// Startup is split into named phases, each phase ends when the next one is
+// marked. Once the first frame has been committed to an output a single
+// report of all phases is logged.
+
+void
+hikari_startup_begin(void);
+
+void
+hikari_startup_phase(const char *name);
+
+void
+hikari_startup_autostart(void);
+
+void
+hikari_startup_first_frame(void);
+
+#endif
@@ -2,11 +2,13 @@
 #define HIKARI_SWITCH_CONFIG_H
 
 #include <hikari/action.h>
+#include <hikari/hash_map.h>
 
 struct hikari_switch_config {
   struct wl_list link;
 
   char *switch_name;
+  struct hikari_hash_map_entry name_entry;
   struct hikari_action action;
 };
 
@@ -11,6 +11,7 @@ struct hikari_tile {
   struct hikari_layout *layout;
   struct wlr_box view_geometry;
   struct wlr_box tile_geometry;
+  int container;
 
   struct wl_list layout_tiles;
 };
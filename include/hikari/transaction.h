@@ -0,0 +1,47 @@
+#if !defined(HIKARI_TRANSACTION_H)
+#define HIKARI_TRANSACTION_H
+
+#include <stdbool.h>
+
+#include <wayland-server-core.h>
+#include <wayland-util.h>
+
+#include <wlr/util/box.h>
+
+struct hikari_view;
+
+struct hikari_transaction {
+  struct wl_list members;
+  int pending;
+  bool collecting;
+
+  struct wl_event_source *timeout;
+};
+
+struct hikari_transaction_member {
+  struct hikari_transaction *transaction;
+  struct wl_list transaction_members;
+
+  bool ready;
+  struct wlr_box geometry;
+};
+
+void
+hikari_transaction_member_init(struct hikari_transaction_member *member);
+
+struct hikari_transaction *
+hikari_transaction_begin(void);
+
+void
+hikari_transaction_end(struct hikari_transaction *transaction);
+
+void
+hikari_transaction_add(struct hikari_view *view);
+
+bool
+hikari_transaction_defer(struct hikari_view *view, struct wlr_box *geometry);
+
+void
+hikari_transaction_remove(struct hikari_view *view);
+
+#endif
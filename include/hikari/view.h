@@ -17,6 +17,7 @@
 #include <hikari/server.h>
 #include <hikari/sheet.h>
 #include <hikari/tile.h>
+#include <hikari/transaction.h>
 #include <hikari/workspace.h>
 
 struct hikari_mark;
@@ -49,16 +50,19 @@ struct hikari_view {
 
   struct wlr_box geometry;
   struct hikari_maximized_state *maximized_state;
+  struct hikari_sheet *tileable_sheet;
 
   struct wl_list output_views;
   struct wl_list workspace_views;
   struct wl_list sheet_views;
+  struct wl_list tileable_sheet_views;
   struct wl_list group_views;
   struct wl_list visible_group_views;
   struct wl_list visible_server_views;
   struct wl_list children;
 
   struct hikari_operation pending_operation;
+  struct hikari_transaction_member transaction;
 
   struct wlr_box *current_geometry;
   struct wlr_box *current_unmaximized_geometry;
@@ -171,6 +175,12 @@ VIEW_ACTION(toggle_public)
 VIEW_ACTION(reset_geometry)
 #undef VIEW_ACTION
 
+void
+hikari_view_conceal(struct hikari_view *view);
+
+void
+hikari_view_restack(struct hikari_view **views, int nr_of_views, bool raise);
+
 void
 hikari_view_map(struct hikari_view *view, struct wlr_surface *surface);
 
@@ -237,8 +247,10 @@ void
 hikari_view_assign_sheet(struct hikari_view *view, struct hikari_sheet *sheet);
 
 void
-hikari_view_tile(
-    struct hikari_view *view, struct wlr_box *geometry, bool center);
+hikari_view_tile(struct hikari_view *view,
+    struct wlr_box *geometry,
+    int container,
+    bool center);
 
 void
 hikari_view_exchange(struct hikari_view *from, struct hikari_view *to);
@@ -277,6 +289,11 @@ static inline void
 hikari_view_set_dirty(struct hikari_view *view)
 {
   assert(view != NULL);
+
+  if (!view->pending_operation.dirty && view->tileable_sheet != NULL) {
+    view->tileable_sheet->nr_of_dirty_tileable_views++;
+  }
+
   view->pending_operation.dirty = true;
 }
 
@@ -284,6 +301,11 @@ static inline void
 hikari_view_unset_dirty(struct hikari_view *view)
 {
   assert(view != NULL);
+
+  if (view->pending_operation.dirty && view->tileable_sheet != NULL) {
+    view->tileable_sheet->nr_of_dirty_tileable_views--;
+  }
+
   view->pending_operation.dirty = false;
 }
 
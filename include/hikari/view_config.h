@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include <wayland-util.h>
 
+#include <hikari/hash_map.h>
 #include <hikari/position_config.h>
 
 struct hikari_mark;
@@ -25,6 +26,7 @@ struct hikari_view_config {
   struct wl_list link;
 
   char *app_id;
+  struct hikari_hash_map_entry matcher_entry;
 
   struct hikari_view_properties properties;
   struct hikari_view_properties *child_properties;
@@ -0,0 +1,42 @@
+#if !defined(HIKARI_VIEW_MATCHER_H)
+#define HIKARI_VIEW_MATCHER_H
+
+#include <stdbool.h>
+
+#include <hikari/hash_map.h>
+
+struct hikari_view_config;
+struct view_pattern;
+struct view_match;
+
+// Resolves view ids to view configurations. Exact ids take precedence over
+// glob patterns which take precedence over regular expressions, patterns of
+// the same kind are tried in the order they have been added. Results are
+// cached per id for the lifetime of the matcher.
+
+struct hikari_view_matcher {
+  struct hikari_hash_map exact;
+
+  struct view_pattern *patterns;
+  int nr_of_patterns;
+
+  struct hikari_hash_map cache;
+  struct view_match **matches;
+  int nr_of_matches;
+};
+
+void
+hikari_view_matcher_init(struct hikari_view_matcher *view_matcher);
+
+void
+hikari_view_matcher_fini(struct hikari_view_matcher *view_matcher);
+
+bool
+hikari_view_matcher_add(struct hikari_view_matcher *view_matcher,
+    struct hikari_view_config *view_config);
+
+struct hikari_view_config *
+hikari_view_matcher_match(
+    struct hikari_view_matcher *view_matcher, const char *app_id);
+
+#endif
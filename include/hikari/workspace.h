@@ -50,6 +50,9 @@ void
 hikari_workspace_focus_view(
     struct hikari_workspace *workspace, struct hikari_view *view);
 
+void
+hikari_workspace_commit_focus(struct hikari_workspace *workspace);
+
 void
 hikari_workspace_move_view(struct hikari_workspace *workspace, int dx, int dy);
 
@@ -7,12 +7,14 @@
 
 #include <hikari/view.h>
 
+struct hikari_decoration;
 struct hikari_renderer;
 
 struct hikari_xdg_view {
   struct hikari_view view;
 
   struct wlr_xdg_surface *surface;
+  struct hikari_decoration *decoration;
 
   struct wl_listener map;
   struct wl_listener unmap;
@@ -3,6 +3,8 @@
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <hikari/input_log.h>
+#include <hikari/latency.h>
 #include <hikari/log.h>
 #include <hikari/server.h>
 
@@ -131,12 +133,17 @@ const char *usage = "Usage: hikari [options]\n"
                     "  -a <executable> Specify an autostart executable.\n"
                     "  -c <config>     Specify a configuration file.\n"
                     "  -h              Show this message and quit.\n"
+                    "  -l              Report input-to-photon latency.\n"
+                    "  -p <log>        Replay an input log.\n"
+                    "  -r <log>        Record input into a log.\n"
                     "  -v              Show version and quit.\n"
                     "\n";
 
 struct options {
   char *config_path;
   char *autostart;
+  char *record_path;
+  char *replay_path;
 };
 
 static void
@@ -145,8 +152,11 @@ parse_options(int argc, char **argv, struct options *options)
   char *config_path = NULL;
   char *autostart = NULL;
 
+  options->record_path = NULL;
+  options->replay_path = NULL;
+
   char flag;
-  while ((flag = getopt(argc, argv, "vhc:a:")) != -1) {
+  while ((flag = getopt(argc, argv, "vhlc:a:p:r:")) != -1) {
     switch (flag) {
       case 'a':
         free(autostart);
@@ -158,6 +168,20 @@ parse_options(int argc, char **argv, struct options *options)
         config_path = strdup(optarg);
         break;
 
+      case 'l':
+        hikari_latency_enable();
+        break;
+
+      case 'p':
+        free(options->replay_path);
+        options->replay_path = strdup(optarg);
+        break;
+
+      case 'r':
+        free(options->record_path);
+        options->record_path = strdup(optarg);
+        break;
+
       case 'v':
         free(config_path);
         free(autostart);
@@ -208,6 +232,22 @@ main(int argc, char **argv)
     assert(geteuid() != 0 && geteuid() == getuid());
     assert(getegid() != 0 && getegid() == getgid());
 
+    bool input_log = (options.record_path == NULL ||
+                         hikari_input_log_record(options.record_path)) &&
+                     (options.replay_path == NULL ||
+                         hikari_input_log_replay(options.replay_path));
+
+    free(options.record_path);
+    free(options.replay_path);
+
+    if (!input_log) {
+      free(options.config_path);
+      free(options.autostart);
+      hikari_input_log_fini();
+
+      return EXIT_FAILURE;
+    }
+
     hikari_server_start(options.config_path, options.autostart);
     hikari_server_stop();
 
@@ -43,6 +43,9 @@ parse_binding(struct wl_list *action_configs,
   } else if (!strcmp(str, "reload")) {
     *action = hikari_server_reload;
     *arg = NULL;
+  } else if (!strcmp(str, "memory-dump")) {
+    *action = hikari_server_dump_memory;
+    *arg = NULL;
 #ifndef NDEBUG
   } else if (!strcmp(str, "debug-damage")) {
     *action = hikari_server_toggle_damage_tracking;
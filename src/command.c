@@ -1,33 +1,206 @@
+// POSIX_SPAWN_SETSID is an extension on glibc
+#define _GNU_SOURCE
+
 #include <hikari/command.h>
 
 #include <errno.h>
-#include <stdlib.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdint.h>
+#include <string.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
+#include <wayland-server-core.h>
+
+#include <hikari/log.h>
+#include <hikari/memory.h>
+
+// Commands are started with posix_spawn so launching does not copy the
+// compositor's address space. Children are reaped from a SIGCHLD handler on
+// the event loop instead of blocking in waitpid.
+
+extern char **environ;
+
+struct command_child {
+  struct wl_list link;
+
+  pid_t pid;
+  uint64_t spawn_nsec;
+};
+
+static struct {
+  struct wl_event_source *event_source;
+  struct wl_list children;
+  bool initialized;
+} command = { .event_source = NULL, .initialized = false };
+
+static uint64_t
+now_nsec(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static double
+to_msec(uint64_t nsec)
+{
+  return nsec / 1000000.0;
+}
+
+static void
+reap_children(void)
+{
+  struct command_child *child, *child_temp;
+  wl_list_for_each_safe (child, child_temp, &command.children, link) {
+    int status;
+    pid_t pid = waitpid(child->pid, &status, WNOHANG);
+
+    if (pid == 0 || (pid == -1 && errno == EINTR)) {
+      continue;
+    }
+
+    if (pid == child->pid) {
+      hikari_log_debug("command: pid %d exited with status %d after %.1fms",
+          child->pid,
+          WIFEXITED(status) ? WEXITSTATUS(status) : -1,
+          to_msec(now_nsec() - child->spawn_nsec));
+    }
+
+    wl_list_remove(&child->link);
+    hikari_free(child);
+  }
+}
+
+static int
+child_handler(int signal, void *data)
+{
+  (void)signal;
+  (void)data;
+
+  reap_children();
+
+  return 0;
+}
+
+bool
+hikari_command_init(struct wl_event_loop *event_loop)
+{
+  wl_list_init(&command.children);
+  command.initialized = true;
+
+  // blocks SIGCHLD in the calling thread, do this before starting workers so
+  // they inherit the mask and the signal is only ever seen by the event loop
+  command.event_source =
+      wl_event_loop_add_signal(event_loop, SIGCHLD, child_handler, NULL);
+
+  if (command.event_source == NULL) {
+    hikari_log_error("could not watch for terminated commands");
+    return false;
+  }
+
+  return true;
+}
+
+void
+hikari_command_fini(void)
+{
+  if (!command.initialized) {
+    return;
+  }
+
+  if (command.event_source != NULL) {
+    wl_event_source_remove(command.event_source);
+    command.event_source = NULL;
+  }
+
+  reap_children();
+
+  // commands that are still running are left to init
+  struct command_child *child, *child_temp;
+  wl_list_for_each_safe (child, child_temp, &command.children, link) {
+    wl_list_remove(&child->link);
+    hikari_free(child);
+  }
+
+  command.initialized = false;
+}
+
+static bool
+init_attributes(posix_spawnattr_t *attributes)
+{
+  sigset_t all_signals;
+  sigset_t no_signals;
+  short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+
+  if (posix_spawnattr_init(attributes) != 0) {
+    return false;
+  }
+
+#ifdef POSIX_SPAWN_SETSID
+  flags |= POSIX_SPAWN_SETSID;
+#else
+  flags |= POSIX_SPAWN_SETPGROUP;
+  posix_spawnattr_setpgroup(attributes, 0);
+#endif
+
+  // the compositor blocks SIGCHLD and ignores SIGPIPE, neither must leak into
+  // the command
+  sigemptyset(&no_signals);
+  sigfillset(&all_signals);
+  sigdelset(&all_signals, SIGKILL);
+  sigdelset(&all_signals, SIGSTOP);
+
+  if (posix_spawnattr_setflags(attributes, flags) != 0 ||
+      posix_spawnattr_setsigmask(attributes, &no_signals) != 0 ||
+      posix_spawnattr_setsigdefault(attributes, &all_signals) != 0) {
+    posix_spawnattr_destroy(attributes);
+    return false;
+  }
+
+  return true;
+}
+
 void
 hikari_command_execute(const char *cmd)
 {
-  pid_t child;
-  int status;
+  posix_spawnattr_t attributes;
+  char *argv[] = { "/bin/sh", "-c", (char *)cmd, NULL };
+  uint64_t start_nsec = now_nsec();
+  pid_t pid;
+  int error;
 
-  child = fork();
-  if (child == 0) {
-    child = fork();
-    if (child == 0) {
-      setsid();
-      execl("/bin/sh", "/bin/sh", "-c", cmd, NULL);
-      _exit(127);
-    }
-    _exit(child == -1);
+  if (!init_attributes(&attributes)) {
+    hikari_log_error("could not prepare to execute \"%s\"", cmd);
+    return;
   }
 
-  for (;;) {
-    if (waitpid(child, &status, 0) == -1) {
-      if (errno == EINTR) {
-        continue;
-      }
-    }
+  error = posix_spawn(&pid, "/bin/sh", NULL, &attributes, argv, environ);
+  posix_spawnattr_destroy(&attributes);
+
+  if (error != 0) {
+    hikari_log_error("could not execute \"%s\": %s", cmd, strerror(error));
     return;
   }
+
+  uint64_t spawn_nsec = now_nsec();
+
+  hikari_log_info("command: pid=%d spawn=%.2fms cmd=%s",
+      pid,
+      to_msec(spawn_nsec - start_nsec),
+      cmd);
+
+  if (!command.initialized) {
+    return;
+  }
+
+  struct command_child *child = hikari_malloc(sizeof(struct command_child));
+
+  child->pid = pid;
+  child->spawn_nsec = spawn_nsec;
+
+  wl_list_insert(&command.children, &child->link);
 }
@@ -7,78 +7,171 @@
 #include <hikari/memory.h>
 
 void
-hikari_completion_init(struct hikari_completion *completion, char *data)
+hikari_completion_index_init(struct hikari_completion_index *index)
 {
-  struct hikari_completion_item *item;
-  wl_list_init(&completion->items);
-  hikari_completion_add(completion, data);
-  item = wl_container_of(completion->items.next, item, completion_items);
-  completion->current_item = item;
+  index->names = NULL;
+  index->nr_of_names = 0;
+  index->capacity = 0;
 }
 
 void
-hikari_completion_fini(struct hikari_completion *completion)
+hikari_completion_index_fini(struct hikari_completion_index *index)
 {
-  assert(completion != NULL);
+  hikari_free(index->names);
+  index->names = NULL;
+  index->nr_of_names = 0;
+  index->capacity = 0;
+}
+
+static int
+lower_bound(struct hikari_completion_index *index, const char *name)
+{
+  int low = 0;
+  int high = index->nr_of_names;
+
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+
+    if (strcmp(index->names[mid], name) < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
 
-  struct hikari_completion_item *item = NULL, *item_temp;
+  return low;
+}
 
-  wl_list_for_each_safe (
-      item, item_temp, &completion->items, completion_items) {
-    wl_list_remove(&item->completion_items);
-    hikari_free(item);
+static int
+prefix_end(struct hikari_completion_index *index, int start, const char *prefix)
+{
+  size_t length = strlen(prefix);
+  int low = start;
+  int high = index->nr_of_names;
+
+  while (low < high) {
+    int mid = low + (high - low) / 2;
+
+    if (strncmp(index->names[mid], prefix, length) <= 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
   }
+
+  return low;
 }
 
 void
-hikari_completion_add(struct hikari_completion *completion, char *data)
+hikari_completion_index_insert(
+    struct hikari_completion_index *index, char *name)
 {
-  assert(completion != NULL);
+  if (index->nr_of_names == index->capacity) {
+    index->capacity = index->capacity == 0 ? 16 : index->capacity * 2;
+    index->names =
+        hikari_realloc(index->names, index->capacity * sizeof(char *));
+  }
+
+  int position = lower_bound(index, name);
 
-  struct hikari_completion_item *completion_item =
-      hikari_malloc(sizeof(struct hikari_completion_item));
+  memmove(&index->names[position + 1],
+      &index->names[position],
+      (index->nr_of_names - position) * sizeof(char *));
 
-  strncpy(completion_item->data, data, sizeof(completion_item->data) - 1);
-  completion_item->data[sizeof(completion_item->data) - 1] = '\0';
+  index->names[position] = name;
+  index->nr_of_names++;
+}
+
+void
+hikari_completion_index_remove(
+    struct hikari_completion_index *index, char *name)
+{
+  int position = lower_bound(index, name);
+
+  // names are compared by identity, equal names may be indexed more than once
+  while (position < index->nr_of_names && index->names[position] != name) {
+    assert(!strcmp(index->names[position], name));
+    position++;
+  }
+
+  assert(position < index->nr_of_names);
+
+  index->nr_of_names--;
+
+  memmove(&index->names[position],
+      &index->names[position + 1],
+      (index->nr_of_names - position) * sizeof(char *));
+}
+
+void
+hikari_completion_init(struct hikari_completion *completion,
+    struct hikari_completion_index *index,
+    char *data)
+{
+  completion->index = index;
+  completion->current = 0;
 
-  wl_list_insert(completion->items.prev, &completion_item->completion_items);
+  strncpy(completion->data, data, sizeof(completion->data) - 1);
+  completion->data[sizeof(completion->data) - 1] = '\0';
+}
+
+void
+hikari_completion_fini(struct hikari_completion *completion)
+{
+  assert(completion != NULL);
+
+  completion->index = NULL;
 }
 
 char *
 hikari_completion_cancel(struct hikari_completion *completion)
 {
   assert(completion != NULL);
-  assert(!wl_list_empty(&completion->items));
 
-  struct hikari_completion_item *item =
-      wl_container_of(completion->items.next, item, completion_items);
+  completion->current = 0;
 
-  completion->current_item = item;
-
-  return item->data;
+  return completion->data;
 }
 
-#define COMPLETION(link)                                                       \
-  char *hikari_completion_##link(struct hikari_completion *completion)         \
-  {                                                                            \
-    assert(completion != NULL);                                                \
-    assert(!wl_list_empty(&completion->items));                                \
-                                                                               \
-    struct wl_list *link;                                                      \
-    struct hikari_completion_item *item;                                       \
-                                                                               \
-    link = completion->current_item->completion_items.link;                    \
-    if (link == &completion->items) {                                          \
-      item = wl_container_of(completion->items.link, item, completion_items);  \
-    } else {                                                                   \
-      item = wl_container_of(link, item, completion_items);                    \
-    }                                                                          \
-                                                                               \
-    completion->current_item = item;                                           \
-                                                                               \
-    return item->data;                                                         \
+// Candidates are looked up on every step because the index can change while
+// cycling, position 0 is the original input followed by all names that
+// extend it.
+static char *
+cycle(struct hikari_completion *completion, int step)
+{
+  assert(completion != NULL);
+
+  struct hikari_completion_index *index = completion->index;
+  char *prefix = completion->data;
+
+  int start = lower_bound(index, prefix);
+  int end = prefix_end(index, start, prefix);
+
+  while (start < end && !strcmp(index->names[start], prefix)) {
+    start++;
   }
 
-COMPLETION(next)
-COMPLETION(prev)
-#undef COMPLETION
+  int nr_of_positions = end - start + 1;
+  int current = completion->current % nr_of_positions;
+
+  current = (current + step + nr_of_positions) % nr_of_positions;
+  completion->current = current;
+
+  if (current == 0) {
+    return completion->data;
+  }
+
+  return index->names[start + current - 1];
+}
+
+char *
+hikari_completion_next(struct hikari_completion *completion)
+{
+  return cycle(completion, 1);
+}
+
+char *
+hikari_completion_prev(struct hikari_completion *completion)
+{
+  return cycle(completion, -1);
+}
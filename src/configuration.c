@@ -2,6 +2,7 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <limits.h>
 
 #include <ucl.h>
 
@@ -19,6 +20,8 @@
 #include <hikari/geometry.h>
 #include <hikari/keyboard.h>
 #include <hikari/keyboard_config.h>
+#include <hikari/keymap.h>
+#include <hikari/keymap_cache.h>
 #include <hikari/layout.h>
 #include <hikari/layout_config.h>
 #include <hikari/mark.h>
@@ -134,7 +137,8 @@ parse_container(
     goto done;
   }
 
-  ret = hikari_malloc(sizeof(struct hikari_split_container));
+  ret = hikari_tagged_malloc(
+      HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_container));
   hikari_split_container_init(ret, views, layout_func);
 
   success = true;
@@ -208,7 +212,8 @@ parse_split(const ucl_object_t *split_obj, struct hikari_split **split)
       goto done;
     }
 
-    ret = hikari_malloc(sizeof(struct hikari_split_container));
+    ret = hikari_tagged_malloc(
+        HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_container));
     hikari_split_container_init(
         (struct hikari_split_container *)ret, views, layout_func);
 
@@ -429,7 +434,8 @@ done:
       goto done;                                                               \
     }                                                                          \
                                                                                \
-    ret = hikari_malloc(sizeof(struct hikari_split_##name));                   \
+    ret = hikari_tagged_malloc(                                                \
+        HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_##name));            \
     hikari_split_##name##_init(ret, &scale, orientation, first, second);       \
                                                                                \
     success = true;                                                            \
@@ -453,12 +459,7 @@ hikari_configuration_resolve_view_config(
   assert(app_id != NULL);
 
   if (app_id != NULL) {
-    struct hikari_view_config *view_config;
-    wl_list_for_each (view_config, &configuration->view_configs, link) {
-      if (!strcmp(view_config->app_id, app_id)) {
-        return view_config;
-      }
-    }
+    return hikari_view_matcher_match(&configuration->view_matcher, app_id);
   }
 
   return NULL;
@@ -627,8 +628,8 @@ parse_view_configs(
 
   const ucl_object_t *cur;
   while ((cur = ucl_object_iterate_safe(it, false)) != NULL) {
-    struct hikari_view_config *view_config =
-        hikari_malloc(sizeof(struct hikari_view_config));
+    struct hikari_view_config *view_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_view_config));
 
     hikari_view_config_init(view_config);
     wl_list_insert(&configuration->view_configs, &view_config->link);
@@ -636,7 +637,8 @@ parse_view_configs(
     const char *key = ucl_object_key(cur);
     size_t keylen = strlen(key);
 
-    view_config->app_id = hikari_malloc(keylen + 1);
+    view_config->app_id =
+        hikari_tagged_malloc(HIKARI_MEMORY_CONFIGURATION, keylen + 1);
     strcpy(view_config->app_id, key);
 
     if (!hikari_view_config_parse(view_config, cur)) {
@@ -644,6 +646,10 @@ parse_view_configs(
           key);
       goto done;
     }
+
+    if (!hikari_view_matcher_add(&configuration->view_matcher, view_config)) {
+      goto done;
+    }
   }
 
   success = true;
@@ -712,7 +718,8 @@ parse_actions(
       goto done;
     }
 
-    action_config = hikari_malloc(sizeof(struct hikari_action_config));
+    action_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_action_config));
     hikari_action_config_init(action_config, key, command);
 
     wl_list_insert(&configuration->action_configs, &action_config->link);
@@ -769,7 +776,8 @@ parse_layouts(
       goto done;
     }
 
-    layout_config = hikari_malloc(sizeof(struct hikari_layout_config));
+    layout_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_layout_config));
     hikari_layout_config_init(layout_config, layout_register, split);
 
     wl_list_insert(&configuration->layout_configs, &layout_config->link);
@@ -823,7 +831,8 @@ parse_keyboard_bindings(struct hikari_configuration *configuration,
   while ((cur = ucl_object_iterate_safe(it, false)) != NULL) {
     const char *key = ucl_object_key(cur);
 
-    binding_config = hikari_malloc(sizeof(struct hikari_binding_config));
+    binding_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_binding_config));
     wl_list_insert(
         &configuration->keyboard_binding_configs, &binding_config->link);
 
@@ -847,22 +856,34 @@ done:
   return success;
 }
 
+#define ADD_CONFIG(name, field)                                                \
+  static void add_##name##_config(                                             \
+      struct hikari_configuration *configuration,                              \
+      struct hikari_##name##_config *name##_config)                            \
+  {                                                                            \
+    wl_list_insert(&configuration->name##_configs, &name##_config->link);      \
+    hikari_hash_map_insert(&configuration->name##_configs_by_name,             \
+        &name##_config->name_entry,                                            \
+        name##_config->field);                                                 \
+  }
+
+ADD_CONFIG(output, output_name)
+ADD_CONFIG(pointer, name)
+ADD_CONFIG(keyboard, keyboard_name)
+ADD_CONFIG(switch, switch_name)
+#undef ADD_CONFIG
+
 static bool
 finalize_keyboard_configs(struct hikari_configuration *configuration)
 {
   struct hikari_keyboard_config *keyboard_config;
 
   if (wl_list_empty(&configuration->keyboard_configs)) {
-    keyboard_config = hikari_malloc(sizeof(struct hikari_keyboard_config));
+    keyboard_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_keyboard_config));
     hikari_keyboard_config_default(keyboard_config);
 
-    wl_list_insert(&configuration->keyboard_configs, &keyboard_config->link);
-  }
-
-  wl_list_for_each (keyboard_config, &configuration->keyboard_configs, link) {
-    if (!hikari_keyboard_config_compile_keymap(keyboard_config)) {
-      return false;
-    }
+    add_keyboard_config(configuration, keyboard_config);
   }
 
   return true;
@@ -880,7 +901,8 @@ parse_mouse_bindings(struct hikari_configuration *configuration,
   while ((cur = ucl_object_iterate_safe(it, false)) != NULL) {
     const char *key = ucl_object_key(cur);
 
-    binding_config = hikari_malloc(sizeof(struct hikari_binding_config));
+    binding_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_binding_config));
     wl_list_insert(
         &configuration->mouse_binding_configs, &binding_config->link);
 
@@ -1130,10 +1152,11 @@ parse_pointers(struct hikari_configuration *configuration,
   while ((cur = ucl_object_iterate_safe(it, true)) != NULL) {
     const char *pointer_name = ucl_object_key(cur);
 
-    pointer_config = hikari_malloc(sizeof(struct hikari_pointer_config));
+    pointer_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_pointer_config));
     hikari_pointer_config_init(pointer_config, pointer_name);
 
-    wl_list_insert(&configuration->pointer_configs, &pointer_config->link);
+    add_pointer_config(configuration, pointer_config);
 
     if (!parse_pointer_config(pointer_config, cur)) {
       goto done;
@@ -1172,10 +1195,11 @@ parse_keyboards(struct hikari_configuration *configuration,
   while ((cur = ucl_object_iterate_safe(it, true)) != NULL) {
     const char *keyboard_name = ucl_object_key(cur);
 
-    keyboard_config = hikari_malloc(sizeof(struct hikari_keyboard_config));
+    keyboard_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_keyboard_config));
     hikari_keyboard_config_init(keyboard_config, keyboard_name);
 
-    wl_list_insert(&configuration->keyboard_configs, &keyboard_config->link);
+    add_keyboard_config(configuration, keyboard_config);
 
     if (!hikari_keyboard_config_parse(keyboard_config, cur)) {
       goto done;
@@ -1185,10 +1209,11 @@ parse_keyboards(struct hikari_configuration *configuration,
   struct hikari_keyboard_config *default_config =
       hikari_configuration_resolve_keyboard_config(configuration, "*");
   if (default_config == NULL) {
-    default_config = hikari_malloc(sizeof(struct hikari_keyboard_config));
+    default_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_keyboard_config));
     hikari_keyboard_config_default(default_config);
 
-    wl_list_insert(&configuration->keyboard_configs, &default_config->link);
+    add_keyboard_config(configuration, default_config);
   }
 
   wl_list_for_each (keyboard_config, &configuration->keyboard_configs, link) {
@@ -1217,11 +1242,12 @@ parse_switches(struct hikari_configuration *configuration,
   while ((cur = ucl_object_iterate_safe(it, true)) != NULL) {
     const char *key = ucl_object_key(cur);
 
-    switch_config = hikari_malloc(sizeof(struct hikari_switch_config));
-    wl_list_insert(&configuration->switch_configs, &switch_config->link);
-
+    switch_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_switch_config));
     switch_config->switch_name = strdup(key);
 
+    add_switch_config(configuration, switch_config);
+
     if (!hikari_action_parse(
             &switch_config->action, &configuration->action_configs, cur)) {
       goto done;
@@ -1399,10 +1425,11 @@ parse_outputs(
   while ((cur = ucl_object_iterate_safe(it, true)) != NULL) {
     const char *output_name = ucl_object_key(cur);
 
-    output_config = hikari_malloc(sizeof(struct hikari_output_config));
+    output_config = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_output_config));
     hikari_output_config_init(output_config, output_name);
 
-    wl_list_insert(&configuration->output_configs, &output_config->link);
+    add_output_config(configuration, output_config);
 
     if (!parse_output_config(output_config, cur)) {
       hikari_log_error("configuration error: failed to parse \"outputs\" configuration");
@@ -1477,6 +1504,24 @@ parse_step(
   return true;
 }
 
+static bool
+parse_layout_timeout(struct hikari_configuration *configuration,
+    const ucl_object_t *layout_timeout_obj)
+{
+  int64_t layout_timeout;
+
+  if (!ucl_object_toint_safe(layout_timeout_obj, &layout_timeout) ||
+      layout_timeout < 0) {
+    hikari_log_error("configuration error: expected non-negative integer for "
+                     "\"layout-timeout\"");
+    return false;
+  }
+
+  configuration->layout_timeout = layout_timeout;
+
+  return true;
+}
+
 static bool
 parse_font(
     struct hikari_configuration *configuration, const ucl_object_t *font_obj)
@@ -1524,6 +1569,55 @@ parse_ui(struct hikari_configuration *configuration, const ucl_object_t *ui_obj)
       if (!parse_step(configuration, cur)) {
         goto done;
       }
+    } else if (!strcmp(key, "layout-timeout")) {
+      if (!parse_layout_timeout(configuration, cur)) {
+        goto done;
+      }
+    }
+  }
+
+  success = true;
+
+done:
+  ucl_object_iterate_free(it);
+
+  return success;
+}
+
+static bool
+parse_xwayland(struct hikari_configuration *configuration,
+    const ucl_object_t *xwayland_obj)
+{
+  bool success = false;
+  ucl_object_iter_t it = ucl_object_iterate_new(xwayland_obj);
+
+  const ucl_object_t *cur;
+  while ((cur = ucl_object_iterate_safe(it, false)) != NULL) {
+    const char *key = ucl_object_key(cur);
+
+    if (!strcmp(key, "lazy")) {
+      bool lazy;
+      if (!ucl_object_toboolean_safe(cur, &lazy)) {
+        hikari_log_error(
+            "configuration error: expected boolean for \"xwayland\" \"lazy\"");
+        goto done;
+      }
+
+      configuration->xwayland_lazy = lazy;
+    } else if (!strcmp(key, "idle-timeout")) {
+      int64_t idle_timeout;
+      if (!ucl_object_toint_safe(cur, &idle_timeout) || idle_timeout < 0 ||
+          idle_timeout > INT_MAX) {
+        hikari_log_error("configuration error: expected non-negative integer "
+                         "for \"xwayland\" \"idle-timeout\"");
+        goto done;
+      }
+
+      configuration->xwayland_idle_timeout = idle_timeout;
+    } else {
+      hikari_log_error(
+          "configuration error: unknown \"xwayland\" key \"%s\"", key);
+      goto done;
     }
   }
 
@@ -1535,10 +1629,101 @@ done:
   return success;
 }
 
+static const char *section_names[HIKARI_NR_OF_CONFIGURATION_SECTIONS] = {
+  [HIKARI_CONFIGURATION_SECTION_UI] = "ui",
+  [HIKARI_CONFIGURATION_SECTION_OUTPUTS] = "outputs",
+  [HIKARI_CONFIGURATION_SECTION_INPUTS] = "inputs",
+  [HIKARI_CONFIGURATION_SECTION_SWITCHES] = "inputs.switches",
+  [HIKARI_CONFIGURATION_SECTION_BINDINGS] = "bindings",
+  [HIKARI_CONFIGURATION_SECTION_LAYOUTS] = "layouts",
+  [HIKARI_CONFIGURATION_SECTION_VIEWS] = "views",
+  [HIKARI_CONFIGURATION_SECTION_ACTIONS] = "actions",
+  [HIKARI_CONFIGURATION_SECTION_MARKS] = "marks",
+};
+
+#define FINGERPRINT_OFFSET 0xcbf29ce484222325
+
+static uint64_t
+fingerprint_bytes(uint64_t fingerprint, const unsigned char *bytes)
+{
+  for (const unsigned char *c = bytes; *c != '\0'; c++) {
+    fingerprint ^= *c;
+    fingerprint *= 0x100000001b3;
+  }
+
+  return fingerprint;
+}
+
+static uint64_t
+fingerprint_object(uint64_t fingerprint, const ucl_object_t *obj)
+{
+  // FNV-1a over the serialized object, environment variables have already
+  // been expanded at this point
+  unsigned char *emitted = ucl_object_emit(obj, UCL_EMIT_JSON_COMPACT);
+
+  fingerprint = fingerprint_bytes(fingerprint, emitted);
+
+  free(emitted);
+
+  return fingerprint;
+}
+
+static uint64_t
+fingerprint_inputs(const ucl_object_t *inputs_obj)
+{
+  uint64_t fingerprint = FINGERPRINT_OFFSET;
+  ucl_object_iter_t it = ucl_object_iterate_new(inputs_obj);
+
+  // switches are a section of their own, changing them must not reconfigure
+  // keyboards and pointers
+  const ucl_object_t *cur;
+  while ((cur = ucl_object_iterate_safe(it, true)) != NULL) {
+    const char *key = ucl_object_key(cur);
+
+    if (!strcmp(key, "switches")) {
+      continue;
+    }
+
+    fingerprint = fingerprint_bytes(fingerprint, (const unsigned char *)key);
+    fingerprint = fingerprint_object(fingerprint, cur);
+  }
+
+  ucl_object_iterate_free(it);
+
+  return fingerprint;
+}
+
+static uint64_t
+fingerprint_section(
+    enum hikari_configuration_section section, const ucl_object_t *section_obj)
+{
+  if (section_obj == NULL) {
+    return 0;
+  }
+
+  if (section == HIKARI_CONFIGURATION_SECTION_INPUTS) {
+    return fingerprint_inputs(section_obj);
+  }
+
+  return fingerprint_object(FINGERPRINT_OFFSET, section_obj);
+}
+#undef FINGERPRINT_OFFSET
+
+static void
+fingerprint_sections(struct hikari_configuration *configuration,
+    const ucl_object_t *configuration_obj)
+{
+  for (int i = 0; i < HIKARI_NR_OF_CONFIGURATION_SECTIONS; i++) {
+    configuration->fingerprints[i] = fingerprint_section(
+        i, ucl_object_lookup_path(configuration_obj, section_names[i]));
+  }
+}
+
 static bool
-set_env_vars(struct ucl_parser *parser)
+set_env_vars(struct ucl_parser *parser, char **environment)
 {
-  for (char **current_var = environ; *current_var != NULL; ++current_var) {
+  for (char **current_var = environment; *current_var != NULL;
+       ++current_var) {
     const char *separator = strchr(*current_var, '=');
     if (separator == NULL) {
       continue;
@@ -1562,9 +1747,17 @@ set_env_vars(struct ucl_parser *parser)
 bool
 hikari_configuration_load(
     struct hikari_configuration *configuration, char *config_path)
+{
+  return hikari_configuration_parse(configuration, config_path, environ);
+}
+
+bool
+hikari_configuration_parse(struct hikari_configuration *configuration,
+    char *config_path,
+    char **environment)
 {
   struct ucl_parser *parser = ucl_parser_new(0);
-  if (!set_env_vars(parser)) {
+  if (!set_env_vars(parser, environment)) {
     ucl_parser_free(parser);
     return false;
   }
@@ -1624,6 +1817,10 @@ hikari_configuration_load(
       if (!parse_inputs(configuration, cur)) {
         goto done;
       }
+    } else if (!strcmp(key, "xwayland")) {
+      if (!parse_xwayland(configuration, cur)) {
+        goto done;
+      }
     } else if (!!strcmp(key, "actions") && !!strcmp(key, "layouts")) {
       hikari_log_error("configuration error: unkown configuration section \"%s\"",
           key);
@@ -1635,6 +1832,8 @@ hikari_configuration_load(
     goto done;
   }
 
+  fingerprint_sections(configuration, configuration_obj);
+
   success = true;
 
 done:
@@ -1645,25 +1844,189 @@ done:
   return success;
 }
 
-bool
-hikari_configuration_reload(char *config_path)
+static void
+swap_lists(struct wl_list *a, struct wl_list *b)
+{
+  struct wl_list tmp;
+
+  wl_list_init(&tmp);
+  wl_list_insert_list(&tmp, a);
+  wl_list_init(a);
+  wl_list_insert_list(a, b);
+  wl_list_init(b);
+  wl_list_insert_list(b, &tmp);
+}
+
+static void
+swap_hash_maps(struct hikari_hash_map *a, struct hikari_hash_map *b)
 {
-  struct hikari_configuration *configuration =
-      hikari_malloc(sizeof(struct hikari_configuration));
+  struct hikari_hash_map tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
 
-  hikari_configuration_init(configuration);
+static void
+swap_colors(float a[4], float b[4])
+{
+  float tmp[4];
 
-  bool success = hikari_configuration_load(configuration, config_path);
+  memcpy(tmp, a, sizeof(tmp));
+  memcpy(a, b, sizeof(tmp));
+  memcpy(b, tmp, sizeof(tmp));
+}
 
-  if (success) {
-    if (hikari_server.workspace->focus_view != NULL) {
-      hikari_indicator_damage(
-          &hikari_server.indicator, hikari_server.workspace->focus_view);
+static void
+swap_ints(int *a, int *b)
+{
+  int tmp = *a;
+  *a = *b;
+  *b = tmp;
+}
+
+static void
+swap_section(struct hikari_configuration *a,
+    struct hikari_configuration *b,
+    enum hikari_configuration_section section)
+{
+  switch (section) {
+    case HIKARI_CONFIGURATION_SECTION_UI: {
+      swap_colors(a->clear, b->clear);
+      swap_colors(a->foreground, b->foreground);
+      swap_colors(a->indicator_selected, b->indicator_selected);
+      swap_colors(a->indicator_grouped, b->indicator_grouped);
+      swap_colors(a->indicator_first, b->indicator_first);
+      swap_colors(a->indicator_conflict, b->indicator_conflict);
+      swap_colors(a->indicator_insert, b->indicator_insert);
+      swap_colors(a->border_active, b->border_active);
+      swap_colors(a->border_inactive, b->border_inactive);
+
+      struct hikari_font font = a->font;
+      a->font = b->font;
+      b->font = font;
+
+      swap_ints(&a->border, &b->border);
+      swap_ints(&a->gap, &b->gap);
+      swap_ints(&a->step, &b->step);
+      swap_ints(&a->layout_timeout, &b->layout_timeout);
+    } break;
+
+    case HIKARI_CONFIGURATION_SECTION_OUTPUTS:
+      swap_lists(&a->output_configs, &b->output_configs);
+      swap_hash_maps(&a->output_configs_by_name, &b->output_configs_by_name);
+      break;
+
+    case HIKARI_CONFIGURATION_SECTION_INPUTS:
+      swap_lists(&a->pointer_configs, &b->pointer_configs);
+      swap_lists(&a->keyboard_configs, &b->keyboard_configs);
+      swap_hash_maps(
+          &a->pointer_configs_by_name, &b->pointer_configs_by_name);
+      swap_hash_maps(
+          &a->keyboard_configs_by_name, &b->keyboard_configs_by_name);
+      break;
+
+    case HIKARI_CONFIGURATION_SECTION_SWITCHES:
+      swap_lists(&a->switch_configs, &b->switch_configs);
+      swap_hash_maps(&a->switch_configs_by_name, &b->switch_configs_by_name);
+      break;
+
+    case HIKARI_CONFIGURATION_SECTION_BINDINGS:
+      swap_lists(&a->keyboard_binding_configs, &b->keyboard_binding_configs);
+      swap_lists(&a->mouse_binding_configs, &b->mouse_binding_configs);
+      break;
+
+    case HIKARI_CONFIGURATION_SECTION_LAYOUTS:
+      swap_lists(&a->layout_configs, &b->layout_configs);
+      break;
+
+    case HIKARI_CONFIGURATION_SECTION_VIEWS: {
+      swap_lists(&a->view_configs, &b->view_configs);
+
+      // this also drops the matches cached for the old view configurations
+      struct hikari_view_matcher view_matcher = a->view_matcher;
+      a->view_matcher = b->view_matcher;
+      b->view_matcher = view_matcher;
+    } break;
+
+    case HIKARI_CONFIGURATION_SECTION_ACTIONS:
+      swap_lists(&a->action_configs, &b->action_configs);
+      break;
+
+    case HIKARI_CONFIGURATION_SECTION_MARKS:
+      for (int i = 0; i < HIKARI_NR_OF_EXECS; i++) {
+        struct hikari_exec exec = a->execs[i];
+        a->execs[i] = b->execs[i];
+        b->execs[i] = exec;
+      }
+      break;
+
+    case HIKARI_NR_OF_CONFIGURATION_SECTIONS:
+      assert(false);
+      break;
+  }
+}
+
+#define SECTION(name) (1 << HIKARI_CONFIGURATION_SECTION_##name)
+
+static uint32_t
+changed_sections(struct hikari_configuration *configuration)
+{
+  uint32_t changed = 0;
+
+  for (int i = 0; i < HIKARI_NR_OF_CONFIGURATION_SECTIONS; i++) {
+    if (configuration->fingerprints[i] !=
+        hikari_configuration->fingerprints[i]) {
+      hikari_log_debug(
+          "configuration section \"%s\" changed", section_names[i]);
+      changed |= 1 << i;
+    }
+  }
+
+  // bindings and switches refer to the commands of the actions they have been
+  // parsed with
+  uint32_t actions = SECTION(ACTIONS) | SECTION(BINDINGS) | SECTION(SWITCHES);
+  if (changed & actions) {
+    changed |= actions;
+  }
+
+  return changed;
+}
+
+void
+hikari_configuration_apply(struct hikari_configuration *configuration)
+{
+  uint32_t changed = changed_sections(configuration);
+
+  if (changed == 0) {
+    hikari_log_info("configuration unchanged");
+    return;
+  }
+
+  struct hikari_view *focus_view = hikari_server.workspace->focus_view;
+
+  if ((changed & SECTION(UI)) && focus_view != NULL) {
+    hikari_indicator_damage(&hikari_server.indicator, focus_view);
+  }
+
+  // replaced sections end up in configuration and get freed along with it,
+  // so everything still referring to them has to be reconfigured below
+  for (int i = 0; i < HIKARI_NR_OF_CONFIGURATION_SECTIONS; i++) {
+    if (changed & (1 << i)) {
+      swap_section(hikari_configuration, configuration, i);
     }
+  }
 
-    hikari_configuration_fini(hikari_configuration);
-    hikari_free(hikari_configuration);
-    hikari_configuration = configuration;
+  memcpy(hikari_configuration->fingerprints,
+      configuration->fingerprints,
+      sizeof(hikari_configuration->fingerprints));
+
+  if (changed & SECTION(INPUTS)) {
+    struct hikari_keyboard_config *keyboard_config;
+    wl_list_for_each (
+        keyboard_config, &hikari_configuration->keyboard_configs, link) {
+      hikari_keyboard_config_compile_keymap(keyboard_config);
+    }
+
+    hikari_keymap_cache_sweep(&hikari_configuration->keyboard_configs);
 
     struct hikari_pointer *pointer;
     wl_list_for_each (pointer, &hikari_server.pointers, server_pointers) {
@@ -1675,10 +2038,16 @@ hikari_configuration_reload(char *config_path)
         hikari_pointer_configure(pointer, pointer_config);
       }
     }
+  }
+
+  if (changed & SECTION(BINDINGS)) {
+    hikari_keymap_invalidate(&hikari_configuration->keyboard_binding_configs);
 
     hikari_cursor_configure_bindings(
-        &hikari_server.cursor, &configuration->mouse_binding_configs);
+        &hikari_server.cursor, &hikari_configuration->mouse_binding_configs);
+  }
 
+  if (changed & (SECTION(INPUTS) | SECTION(BINDINGS))) {
     struct hikari_keyboard *keyboard;
     wl_list_for_each (keyboard, &hikari_server.keyboards, server_keyboards) {
       struct hikari_keyboard_config *keyboard_config =
@@ -1686,17 +2055,24 @@ hikari_configuration_reload(char *config_path)
               hikari_configuration, keyboard->device->name);
 
       assert(keyboard_config != NULL);
-      hikari_keyboard_configure(keyboard, keyboard_config);
-
-      hikari_keyboard_configure_bindings(
-          keyboard, &configuration->keyboard_binding_configs);
+      hikari_keyboard_configure(keyboard,
+          keyboard_config,
+          &hikari_configuration->keyboard_binding_configs);
     }
+  }
 
+  if (changed & (SECTION(UI) | SECTION(OUTPUTS))) {
     struct hikari_output *output;
     wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
-      struct hikari_view *view;
-      wl_list_for_each (view, &output->views, output_views) {
-        hikari_view_refresh_geometry(view, view->current_geometry);
+      if (changed & SECTION(UI)) {
+        struct hikari_view *view;
+        wl_list_for_each (view, &output->views, output_views) {
+          hikari_view_refresh_geometry(view, view->current_geometry);
+        }
+      }
+
+      if (!(changed & SECTION(OUTPUTS))) {
+        continue;
       }
 
       struct hikari_output_config *output_config =
@@ -1721,7 +2097,9 @@ hikari_configuration_reload(char *config_path)
         }
       }
     }
+  }
 
+  if (changed & SECTION(SWITCHES)) {
     struct hikari_switch *swtch;
     wl_list_for_each (swtch, &hikari_server.switches, server_switches) {
       struct hikari_switch_config *switch_config =
@@ -1734,16 +2112,52 @@ hikari_configuration_reload(char *config_path)
         hikari_switch_reset(swtch);
       }
     }
+  }
 
-    if (hikari_server.workspace->focus_view != NULL) {
-      hikari_indicator_update(
-          &hikari_server.indicator, hikari_server.workspace->focus_view);
+  if ((changed & SECTION(UI)) && focus_view != NULL) {
+    hikari_indicator_update(&hikari_server.indicator, focus_view);
+  }
+}
+#undef SECTION
+
+bool
+hikari_configuration_compile_keymaps(
+    struct hikari_configuration *configuration)
+{
+  struct hikari_keyboard_config *keyboard_config;
+  wl_list_for_each (keyboard_config, &configuration->keyboard_configs, link) {
+    if (!hikari_keyboard_config_compile_keymap(keyboard_config)) {
+      hikari_log_error("configuration error: failed to compile keymap for "
+                       "\"%s\"",
+          keyboard_config->keyboard_name);
+      return false;
     }
-  } else {
-    hikari_configuration_fini(configuration);
-    hikari_free(configuration);
   }
 
+  return true;
+}
+
+// called off the event loop, keymaps end up in the keymap cache once the
+// configuration is applied
+bool
+hikari_configuration_build_keymaps(struct hikari_configuration *configuration)
+{
+  bool success = true;
+  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+
+  struct hikari_keyboard_config *keyboard_config;
+  wl_list_for_each (keyboard_config, &configuration->keyboard_configs, link) {
+    if (!hikari_keyboard_config_build_keymap(keyboard_config, context)) {
+      hikari_log_error("configuration error: failed to compile keymap for "
+                       "\"%s\"",
+          keyboard_config->keyboard_name);
+      success = false;
+      break;
+    }
+  }
+
+  xkb_context_unref(context);
+
   return success;
 }
 
@@ -1751,6 +2165,7 @@ void
 hikari_configuration_init(struct hikari_configuration *configuration)
 {
   wl_list_init(&configuration->view_configs);
+  hikari_view_matcher_init(&configuration->view_matcher);
   wl_list_init(&configuration->output_configs);
   wl_list_init(&configuration->pointer_configs);
   wl_list_init(&configuration->keyboard_configs);
@@ -1760,6 +2175,11 @@ hikari_configuration_init(struct hikari_configuration *configuration)
   wl_list_init(&configuration->mouse_binding_configs);
   wl_list_init(&configuration->switch_configs);
 
+  hikari_hash_map_init(&configuration->output_configs_by_name);
+  hikari_hash_map_init(&configuration->pointer_configs_by_name);
+  hikari_hash_map_init(&configuration->keyboard_configs_by_name);
+  hikari_hash_map_init(&configuration->switch_configs_by_name);
+
   hikari_color_convert(configuration->clear, 0x282C34);
   hikari_color_convert(configuration->foreground, 0x000000);
   hikari_color_convert(configuration->indicator_selected, 0xF5E094);
@@ -1775,10 +2195,16 @@ hikari_configuration_init(struct hikari_configuration *configuration)
   configuration->border = 1;
   configuration->gap = 5;
   configuration->step = 100;
+  configuration->layout_timeout = 100;
+
+  configuration->xwayland_lazy = true;
+  configuration->xwayland_idle_timeout = 10;
 
   for (int i = 0; i < HIKARI_NR_OF_EXECS; i++) {
     hikari_exec_init(&configuration->execs[i]);
   }
+
+  memset(configuration->fingerprints, 0, sizeof(configuration->fingerprints));
 }
 
 void
@@ -1790,16 +2216,18 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     wl_list_remove(&view_config->link);
 
     hikari_view_config_fini(view_config);
-    hikari_free(view_config);
+    hikari_tagged_free(view_config);
   }
 
+  hikari_view_matcher_fini(&configuration->view_matcher);
+
   struct hikari_output_config *output_config, *output_config_temp;
   wl_list_for_each_safe (
       output_config, output_config_temp, &configuration->output_configs, link) {
     wl_list_remove(&output_config->link);
 
     hikari_output_config_fini(output_config);
-    hikari_free(output_config);
+    hikari_tagged_free(output_config);
   }
 
   struct hikari_pointer_config *pointer_config, *pointer_config_temp;
@@ -1810,7 +2238,7 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     wl_list_remove(&pointer_config->link);
 
     hikari_pointer_config_fini(pointer_config);
-    hikari_free(pointer_config);
+    hikari_tagged_free(pointer_config);
   }
 
   struct hikari_keyboard_config *keyboard_config, *keyboard_config_temp;
@@ -1821,7 +2249,7 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     wl_list_remove(&keyboard_config->link);
 
     hikari_keyboard_config_fini(keyboard_config);
-    hikari_free(keyboard_config);
+    hikari_tagged_free(keyboard_config);
   }
 
   struct hikari_switch_config *switch_config, *switch_config_temp;
@@ -1830,23 +2258,28 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     wl_list_remove(&switch_config->link);
 
     hikari_switch_config_fini(switch_config);
-    hikari_free(switch_config);
+    hikari_tagged_free(switch_config);
   }
 
+  hikari_hash_map_fini(&configuration->output_configs_by_name);
+  hikari_hash_map_fini(&configuration->pointer_configs_by_name);
+  hikari_hash_map_fini(&configuration->keyboard_configs_by_name);
+  hikari_hash_map_fini(&configuration->switch_configs_by_name);
+
   struct hikari_binding_config *binding_config, *binding_config_temp;
   wl_list_for_each_safe (binding_config,
       binding_config_temp,
       &configuration->keyboard_binding_configs,
       link) {
     wl_list_remove(&binding_config->link);
-    hikari_free(binding_config);
+    hikari_tagged_free(binding_config);
   }
   wl_list_for_each_safe (binding_config,
       binding_config_temp,
       &configuration->mouse_binding_configs,
       link) {
     wl_list_remove(&binding_config->link);
-    hikari_free(binding_config);
+    hikari_tagged_free(binding_config);
   }
 
   struct hikari_layout_config *layout_config, *layout_config_temp;
@@ -1855,7 +2288,7 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     wl_list_remove(&layout_config->link);
 
     hikari_layout_config_fini(layout_config);
-    hikari_free(layout_config);
+    hikari_tagged_free(layout_config);
   }
 
   struct hikari_action_config *action_config, *action_config_temp;
@@ -1864,7 +2297,7 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
     wl_list_remove(&action_config->link);
 
     hikari_action_config_fini(action_config);
-    hikari_free(action_config);
+    hikari_tagged_free(action_config);
   }
 
   for (int i = 0; i < HIKARI_NR_OF_EXECS; i++) {
@@ -1874,76 +2307,30 @@ hikari_configuration_fini(struct hikari_configuration *configuration)
   hikari_font_fini(&configuration->font);
 }
 
-struct hikari_output_config *
-hikari_configuration_resolve_output_config(
-    struct hikari_configuration *configuration, const char *output_name)
-{
-  struct hikari_output_config *output_config;
-  wl_list_for_each (output_config, &configuration->output_configs, link) {
-    if (!strcmp(output_config->output_name, output_name)) {
-      return output_config;
-    }
-  }
-
-  wl_list_for_each (output_config, &configuration->output_configs, link) {
-    if (!strcmp(output_config->output_name, "*")) {
-      return output_config;
-    }
-  }
-
-  return NULL;
-}
-
-struct hikari_pointer_config *
-hikari_configuration_resolve_pointer_config(
-    struct hikari_configuration *configuration, const char *pointer_name)
-{
-  struct hikari_pointer_config *pointer_config;
-  wl_list_for_each (pointer_config, &configuration->pointer_configs, link) {
-    if (!strcmp(pointer_config->name, pointer_name)) {
-      return pointer_config;
-    }
-  }
-
-  wl_list_for_each (pointer_config, &configuration->pointer_configs, link) {
-    if (!strcmp(pointer_config->name, "*")) {
-      return pointer_config;
-    }
-  }
-
-  return NULL;
-}
-
-struct hikari_switch_config *
-hikari_configuration_resolve_switch_config(
-    struct hikari_configuration *configuration, const char *switch_name)
-{
-  struct hikari_switch_config *switch_config;
-  wl_list_for_each (switch_config, &configuration->switch_configs, link) {
-    if (!strcmp(switch_config->switch_name, switch_name)) {
-      return switch_config;
-    }
-  }
-
-  return NULL;
-}
-
-struct hikari_keyboard_config *
-hikari_configuration_resolve_keyboard_config(
-    struct hikari_configuration *configuration, const char *keyboard_name)
-{
-  struct hikari_keyboard_config *keyboard_config;
-  wl_list_for_each (keyboard_config, &configuration->keyboard_configs, link) {
-    if (!strcmp(keyboard_config->keyboard_name, keyboard_name)) {
-      return keyboard_config;
-    }
-  }
-
-  wl_list_for_each (keyboard_config, &configuration->keyboard_configs, link) {
-    if (!strcmp(keyboard_config->keyboard_name, "*")) {
-      return keyboard_config;
-    }
+#define RESOLVE_CONFIG(name, wildcard)                                         \
+  struct hikari_##name##_config *hikari_configuration_resolve_##name##_config( \
+      struct hikari_configuration *configuration, const char *name##_name)     \
+  {                                                                            \
+    struct hikari_hash_map *configs = &configuration->name##_configs_by_name;  \
+    struct hikari_hash_map_entry *entry =                                      \
+        hikari_hash_map_lookup(configs, name##_name);                          \
+                                                                               \
+    if (entry == NULL && wildcard) {                                           \
+      entry = hikari_hash_map_lookup(configs, "*");                            \
+    }                                                                          \
+                                                                               \
+    if (entry == NULL) {                                                       \
+      return NULL;                                                             \
+    }                                                                          \
+                                                                               \
+    struct hikari_##name##_config *name##_config =                             \
+        wl_container_of(entry, name##_config, name_entry);                     \
+                                                                               \
+    return name##_config;                                                      \
   }
 
-  return NULL;
-}
+RESOLVE_CONFIG(output, true)
+RESOLVE_CONFIG(pointer, true)
+RESOLVE_CONFIG(switch, false)
+RESOLVE_CONFIG(keyboard, true)
+#undef RESOLVE_CONFIG
@@ -0,0 +1,295 @@
+#include <hikari/configuration_reload.h>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <hikari/configuration.h>
+#include <hikari/log.h>
+#include <hikari/memory.h>
+
+// Reloads parse the configuration into a fresh struct hikari_configuration on
+// a worker thread. The result is handed back through a pipe and applied on the
+// event loop, the running configuration is never touched by the worker.
+
+extern char **environ;
+
+struct reload_job {
+  char *config_path;
+  char **environment;
+
+  struct hikari_configuration *configuration;
+  bool success;
+};
+
+static struct {
+  struct wl_event_source *event_source;
+  int pipe[2];
+
+  pthread_t worker;
+  bool running;
+  bool stop;
+
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  struct reload_job *queued_job;
+  struct reload_job *done_job;
+
+  // owned by the event loop
+  struct reload_job *current_job;
+  char *pending_config_path;
+} configuration_reload;
+
+static char **
+copy_environment(void)
+{
+  int nr_of_vars = 0;
+  while (environ[nr_of_vars] != NULL) {
+    nr_of_vars++;
+  }
+
+  char **environment = hikari_calloc(nr_of_vars + 1, sizeof(char *));
+  for (int i = 0; i < nr_of_vars; i++) {
+    environment[i] = strdup(environ[i]);
+  }
+
+  return environment;
+}
+
+static struct reload_job *
+create_job(char *config_path)
+{
+  struct reload_job *job = hikari_malloc(sizeof(struct reload_job));
+
+  // the environment might change on the event loop while parsing
+  job->config_path = strdup(config_path);
+  job->environment = copy_environment();
+  job->configuration = hikari_malloc(sizeof(struct hikari_configuration));
+  job->success = false;
+
+  hikari_configuration_init(job->configuration);
+
+  return job;
+}
+
+static void
+destroy_job(struct reload_job *job)
+{
+  for (char **var = job->environment; *var != NULL; var++) {
+    free(*var);
+  }
+
+  hikari_free(job->environment);
+  free(job->config_path);
+
+  hikari_configuration_fini(job->configuration);
+  hikari_free(job->configuration);
+
+  hikari_free(job);
+}
+
+static void
+parse_configuration(struct reload_job *job)
+{
+  // keymaps are part of the configuration, an invalid layout rejects the
+  // reload like any other configuration error
+  job->success =
+      hikari_configuration_parse(
+          job->configuration, job->config_path, job->environment) &&
+      hikari_configuration_build_keymaps(job->configuration);
+}
+
+static void *
+worker(void *data)
+{
+  (void)data;
+
+  pthread_mutex_lock(&configuration_reload.lock);
+  while (!configuration_reload.stop) {
+    if (configuration_reload.queued_job == NULL) {
+      pthread_cond_wait(
+          &configuration_reload.cond, &configuration_reload.lock);
+      continue;
+    }
+
+    struct reload_job *job = configuration_reload.queued_job;
+    configuration_reload.queued_job = NULL;
+
+    pthread_mutex_unlock(&configuration_reload.lock);
+    parse_configuration(job);
+    pthread_mutex_lock(&configuration_reload.lock);
+
+    configuration_reload.done_job = job;
+
+    char c = 0;
+    write(configuration_reload.pipe[1], &c, 1);
+  }
+  pthread_mutex_unlock(&configuration_reload.lock);
+
+  return NULL;
+}
+
+static void
+finish_job(struct reload_job *job)
+{
+  if (job->success) {
+    hikari_configuration_apply(job->configuration);
+  } else {
+    hikari_log_error(
+        "failed to reload configuration, keeping the current one");
+  }
+
+  destroy_job(job);
+}
+
+static bool
+start_worker(void)
+{
+  if (configuration_reload.running) {
+    return true;
+  }
+
+  if (pthread_create(&configuration_reload.worker, NULL, worker, NULL) != 0) {
+    hikari_log_error("could not start configuration reload thread");
+    return false;
+  }
+
+  configuration_reload.running = true;
+
+  return true;
+}
+
+static void
+queue_job(char *config_path)
+{
+  struct reload_job *job = create_job(config_path);
+
+  if (!start_worker()) {
+    parse_configuration(job);
+    finish_job(job);
+    return;
+  }
+
+  configuration_reload.current_job = job;
+
+  pthread_mutex_lock(&configuration_reload.lock);
+  configuration_reload.queued_job = job;
+  pthread_cond_signal(&configuration_reload.cond);
+  pthread_mutex_unlock(&configuration_reload.lock);
+}
+
+static int
+job_done_handler(int fd, uint32_t mask, void *data)
+{
+  (void)mask;
+  (void)data;
+
+  char buf[64];
+  while (read(fd, buf, sizeof(buf)) > 0) {
+  }
+
+  pthread_mutex_lock(&configuration_reload.lock);
+  struct reload_job *job = configuration_reload.done_job;
+  configuration_reload.done_job = NULL;
+  pthread_mutex_unlock(&configuration_reload.lock);
+
+  if (job == NULL) {
+    return 0;
+  }
+
+  configuration_reload.current_job = NULL;
+  finish_job(job);
+
+  // reloads requested while parsing are coalesced into a single one
+  char *config_path = configuration_reload.pending_config_path;
+  if (config_path != NULL) {
+    configuration_reload.pending_config_path = NULL;
+    queue_job(config_path);
+    free(config_path);
+  }
+
+  return 0;
+}
+
+bool
+hikari_configuration_reload_init(struct wl_event_loop *event_loop)
+{
+  configuration_reload.running = false;
+  configuration_reload.stop = false;
+  configuration_reload.queued_job = NULL;
+  configuration_reload.done_job = NULL;
+  configuration_reload.current_job = NULL;
+  configuration_reload.pending_config_path = NULL;
+
+  pthread_mutex_init(&configuration_reload.lock, NULL);
+  pthread_cond_init(&configuration_reload.cond, NULL);
+
+  if (pipe(configuration_reload.pipe) != 0) {
+    hikari_log_error("could not create configuration reload pipe");
+    return false;
+  }
+
+  fcntl(configuration_reload.pipe[0], F_SETFL, O_NONBLOCK);
+  fcntl(configuration_reload.pipe[0], F_SETFD, FD_CLOEXEC);
+  fcntl(configuration_reload.pipe[1], F_SETFD, FD_CLOEXEC);
+
+  configuration_reload.event_source = wl_event_loop_add_fd(event_loop,
+      configuration_reload.pipe[0],
+      WL_EVENT_READABLE,
+      job_done_handler,
+      NULL);
+
+  return configuration_reload.event_source != NULL;
+}
+
+void
+hikari_configuration_reload_fini(void)
+{
+  if (configuration_reload.running) {
+    pthread_mutex_lock(&configuration_reload.lock);
+    configuration_reload.stop = true;
+    pthread_cond_signal(&configuration_reload.cond);
+    pthread_mutex_unlock(&configuration_reload.lock);
+
+    pthread_join(configuration_reload.worker, NULL);
+    configuration_reload.running = false;
+  }
+
+  // a job that is still in flight has either been parsed or was never picked
+  // up by the worker, either way it is owned by the event loop now
+  if (configuration_reload.current_job != NULL) {
+    destroy_job(configuration_reload.current_job);
+    configuration_reload.current_job = NULL;
+  }
+
+  configuration_reload.queued_job = NULL;
+  configuration_reload.done_job = NULL;
+
+  free(configuration_reload.pending_config_path);
+  configuration_reload.pending_config_path = NULL;
+
+  if (configuration_reload.event_source != NULL) {
+    wl_event_source_remove(configuration_reload.event_source);
+    configuration_reload.event_source = NULL;
+  }
+
+  close(configuration_reload.pipe[0]);
+  close(configuration_reload.pipe[1]);
+
+  pthread_cond_destroy(&configuration_reload.cond);
+  pthread_mutex_destroy(&configuration_reload.lock);
+}
+
+void
+hikari_configuration_reload(char *config_path)
+{
+  if (configuration_reload.current_job != NULL) {
+    free(configuration_reload.pending_config_path);
+    configuration_reload.pending_config_path = strdup(config_path);
+    return;
+  }
+
+  queue_job(config_path);
+}
@@ -9,6 +9,8 @@
 
 #include <hikari/binding.h>
 #include <hikari/binding_config.h>
+#include <hikari/input_log.h>
+#include <hikari/latency.h>
 #include <hikari/log.h>
 #include <hikari/memory.h>
 #include <hikari/output.h>
@@ -244,8 +246,12 @@ motion_absolute_handler(struct wl_listener *listener, void *data)
   wlr_cursor_warp_absolute(
       cursor->wlr_cursor, &event->pointer->base, event->x, event->y);
 
+  hikari_input_log_motion(cursor->wlr_cursor->x, cursor->wlr_cursor->y);
+
+  hikari_latency_input_begin();
   hikari_server.mode->cursor_move(event->time_msec);
   cursor_damage_output(cursor->wlr_cursor);
+  hikari_latency_input_end();
 }
 
 static void
@@ -270,8 +276,12 @@ motion_handler(struct wl_listener *listener, void *data)
   wlr_cursor_move(
       cursor->wlr_cursor, &event->pointer->base, event->delta_x, event->delta_y);
 
+  hikari_input_log_motion(cursor->wlr_cursor->x, cursor->wlr_cursor->y);
+
+  hikari_latency_input_begin();
   hikari_server.mode->cursor_move(event->time_msec);
   cursor_damage_output(cursor->wlr_cursor);
+  hikari_latency_input_end();
 }
 
 static void
@@ -282,7 +292,11 @@ button_handler(struct wl_listener *listener, void *data)
   struct hikari_cursor *cursor = wl_container_of(listener, cursor, button);
   struct wlr_pointer_button_event *event = data;
 
+  hikari_input_log_button(event);
+
+  hikari_latency_input_begin();
   hikari_server.mode->button_handler(cursor, event);
+  hikari_latency_input_end();
 }
 
 static void
@@ -293,6 +307,8 @@ axis_handler(struct wl_listener *listener, void *data)
 
   struct wlr_pointer_axis_event *event = data;
 
+  hikari_input_log_axis(event);
+
   wlr_seat_pointer_notify_axis(hikari_server.seat,
       event->time_msec,
       event->orientation,
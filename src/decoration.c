@@ -1,6 +1,7 @@
 #include <hikari/decoration.h>
 
 #include <hikari/memory.h>
+#include <hikari/xdg_view.h>
 
 static void
 set_mode(struct hikari_decoration *decoration)
@@ -30,6 +31,10 @@ destroy_handler(struct wl_listener *listener, void *data)
   struct hikari_decoration *decoration =
       wl_container_of(listener, decoration, destroy);
 
+  if (decoration->xdg_view != NULL) {
+    decoration->xdg_view->decoration = NULL;
+  }
+
   wl_list_remove(&decoration->request_mode.link);
   wl_list_remove(&decoration->destroy.link);
 
@@ -42,6 +47,13 @@ hikari_decoration_init(struct hikari_decoration *decoration,
 {
   decoration->decoration = wlr_decoration;
 
+  // toplevels always exist before their decoration, remember the decoration
+  // on the view so it does not have to be searched for on the initial commit
+  decoration->xdg_view = wlr_decoration->toplevel->base->data;
+  if (decoration->xdg_view != NULL) {
+    decoration->xdg_view->decoration = decoration;
+  }
+
   wl_signal_add(
       &wlr_decoration->events.request_mode, &decoration->request_mode);
   decoration->request_mode.notify = request_mode_handler;
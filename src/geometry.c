@@ -1,7 +1,5 @@
 #include <hikari/geometry.h>
 
-#include <hikari/configuration.h>
-
 #define SPLIT(n, x, y, width, height)                                          \
   void hikari_geometry_split_##n(struct wlr_box *src,                          \
       int width,                                                               \
@@ -66,165 +64,6 @@ hikari_geometry_shrink(struct wlr_box *geometry, int gap)
   }
 }
 
-void
-hikari_geometry_constrain_absolute(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int x, int y)
-{
-  int border = hikari_configuration->border;
-
-  int usable_max_x = usable_area->x + usable_area->width;
-  int usable_min_x = usable_area->x;
-  int usable_max_y = usable_area->y + usable_area->height;
-  int usable_min_y = usable_area->y;
-
-  if (x + geometry->width + border > usable_max_x) {
-    geometry->x = usable_max_x - geometry->width - border;
-  } else if (x - border < usable_min_x) {
-    geometry->x = usable_min_x + border;
-  } else {
-    geometry->x = x;
-  }
-
-  if (y + geometry->height + border > usable_max_y) {
-    geometry->y = usable_max_y - geometry->height - border;
-  } else if (y - border < usable_min_y) {
-    geometry->y = usable_min_y + border;
-  } else {
-    geometry->y = y;
-  }
-}
-
-void
-hikari_geometry_constrain_relative(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int x, int y)
-{
-  int border = hikari_configuration->border;
-  int gap = hikari_configuration->gap * 2 - border;
-
-  int usable_max_x = usable_area->x + usable_area->width - gap;
-  int usable_min_x = usable_area->x - geometry->width + gap;
-  int usable_max_y = usable_area->y + usable_area->height - gap;
-  int usable_min_y = usable_area->y - geometry->height + gap;
-
-  if (x > usable_max_x) {
-    geometry->x = usable_max_x;
-  } else if (x < usable_min_x) {
-    geometry->x = usable_min_x;
-  } else {
-    geometry->x = x;
-  }
-
-  if (y > usable_max_y) {
-    geometry->y = usable_max_y;
-  } else if (y < usable_min_y) {
-    geometry->y = usable_min_y;
-  } else {
-    geometry->y = y;
-  }
-}
-
-#define CENTER(coord, dim)                                                     \
-  static int center_##coord(                                                   \
-      struct wlr_box *geometry, struct wlr_box *usable_area)                   \
-  {                                                                            \
-    int center_usable_area_##coord = usable_area->dim / 2;                     \
-    int center_geometry_##coord = geometry->dim / 2;                           \
-                                                                               \
-    return usable_area->coord + center_usable_area_##coord -                   \
-           center_geometry_##coord;                                            \
-  }
-
-CENTER(x, width)
-CENTER(y, height)
-#undef CENTER
-
-static int
-right_x(struct wlr_box *geometry, struct wlr_box *usable_area)
-{
-  return usable_area->x + usable_area->width - geometry->width +
-         hikari_configuration->border;
-}
-
-static int
-bottom_y(struct wlr_box *geometry, struct wlr_box *usable_area)
-{
-  return usable_area->y + usable_area->height - geometry->height +
-         hikari_configuration->border;
-}
-
-void
-hikari_geometry_position_bottom_left(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = usable_area->x;
-  *y = bottom_y(geometry, usable_area);
-}
-
-void
-hikari_geometry_position_bottom_middle(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = center_x(geometry, usable_area);
-  *y = bottom_y(geometry, usable_area);
-}
-
-void
-hikari_geometry_position_bottom_right(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = right_x(geometry, usable_area);
-  *y = bottom_y(geometry, usable_area);
-}
-
-void
-hikari_geometry_position_center(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = center_x(geometry, usable_area);
-  *y = center_y(geometry, usable_area);
-}
-
-void
-hikari_geometry_position_center_left(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = usable_area->x;
-  *y = center_y(geometry, usable_area);
-}
-
-void
-hikari_geometry_position_center_right(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = right_x(geometry, usable_area);
-  *y = center_y(geometry, usable_area);
-}
-
-void
-hikari_geometry_position_top_left(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  (void)geometry;
-  *x = usable_area->x;
-  *y = usable_area->y;
-}
-
-void
-hikari_geometry_position_top_middle(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = center_x(geometry, usable_area);
-  *y = usable_area->y;
-}
-
-void
-hikari_geometry_position_top_right(
-    struct wlr_box *geometry, struct wlr_box *usable_area, int *x, int *y)
-{
-  *x = right_x(geometry, usable_area);
-  *y = usable_area->y;
-}
-
 void
 hikari_geometry_constrain_size(struct wlr_box *geometry,
     struct wlr_box *usable_area,
@@ -16,13 +16,18 @@ hikari_group_init(struct hikari_group *group, const char *name)
   wl_list_init(&group->visible_views);
 
   wl_list_insert(&hikari_server.groups, &group->server_groups);
+  hikari_hash_map_insert(
+      &hikari_server.groups_by_name, &group->name_entry, group->name);
+  hikari_completion_index_insert(&hikari_server.group_names, group->name);
 }
 
 void
 hikari_group_fini(struct hikari_group *group)
 {
-  hikari_free(group->name);
+  hikari_hash_map_remove(&hikari_server.groups_by_name, &group->name_entry);
+  hikari_completion_index_remove(&hikari_server.group_names, group->name);
   wl_list_remove(&group->server_groups);
+  hikari_free(group->name);
 }
 
 #define GROUP_VIEW(name, link)                                                 \
@@ -42,48 +47,46 @@ GROUP_VIEW(first, next)
 GROUP_VIEW(last, prev)
 #undef GROUP_VIEW
 
-void
-hikari_group_raise(struct hikari_group *group, struct hikari_view *top)
+static void
+restack(struct hikari_group *group, struct hikari_view *top, bool raise)
 {
   assert(group != NULL);
   assert(top != NULL);
 
-  hikari_view_raise(top);
+  int nr_of_views = wl_list_length(&group->visible_views);
+  struct hikari_view **views =
+      hikari_malloc(nr_of_views * sizeof(struct hikari_view *));
 
-  struct hikari_view *view, *view_temp;
-  wl_list_for_each_reverse_safe (
-      view, view_temp, &group->visible_views, visible_group_views) {
+  // top goes first followed by the rest of the group in stacking order
+  int n = 0;
+  views[n++] = top;
+
+  struct hikari_view *view;
+  wl_list_for_each (view, &group->visible_views, visible_group_views) {
     assert(!hikari_view_is_hidden(view));
 
     if (view != top) {
-      hikari_view_raise(view);
-    } else {
-      break;
+      views[n++] = view;
     }
   }
 
-  hikari_view_raise(top);
+  assert(n == nr_of_views);
+
+  hikari_view_restack(views, nr_of_views, raise);
+
+  hikari_free(views);
 }
 
 void
-hikari_group_lower(struct hikari_group *group, struct hikari_view *top)
+hikari_group_raise(struct hikari_group *group, struct hikari_view *top)
 {
-  assert(group != NULL);
-  assert(top != NULL);
-
-  hikari_view_lower(top);
-
-  struct hikari_view *view, *view_temp;
-  wl_list_for_each_safe (
-      view, view_temp, &group->visible_views, visible_group_views) {
-    assert(!hikari_view_is_hidden(view));
+  restack(group, top, true);
+}
 
-    if (view != top) {
-      hikari_view_lower(view);
-    } else {
-      break;
-    }
-  }
+void
+hikari_group_lower(struct hikari_group *group, struct hikari_view *top)
+{
+  restack(group, top, false);
 }
 
 void
@@ -40,21 +40,12 @@ init_completion(void)
     return;
   }
 
-  struct hikari_group *group;
   struct hikari_completion *completion =
       hikari_malloc(sizeof(struct hikari_completion));
 
   char *input = mode->input_buffer.buffer;
 
-  hikari_completion_init(completion, input);
-
-  wl_list_for_each (group, &hikari_server.groups, server_groups) {
-    char *name = group->name;
-
-    if (strstr(name, input) == name && strcmp(name, input) != 0) {
-      hikari_completion_add(completion, name);
-    }
-  }
+  hikari_completion_init(completion, &hikari_server.group_names, input);
 
   mode->completion = completion;
 }
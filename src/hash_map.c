@@ -0,0 +1,137 @@
+#include <hikari/hash_map.h>
+
+#include <assert.h>
+#include <string.h>
+
+#include <hikari/memory.h>
+
+#define INITIAL_NR_OF_BUCKETS 16
+
+uint32_t
+hikari_hash_string(const char *str)
+{
+  // FNV-1a
+  uint32_t hash = 2166136261u;
+
+  for (const unsigned char *c = (const unsigned char *)str; *c != '\0'; c++) {
+    hash ^= *c;
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+void
+hikari_hash_map_init(struct hikari_hash_map *map)
+{
+  map->buckets = NULL;
+  map->nr_of_buckets = 0;
+  map->nr_of_entries = 0;
+}
+
+void
+hikari_hash_map_fini(struct hikari_hash_map *map)
+{
+  hikari_free(map->buckets);
+
+  map->buckets = NULL;
+  map->nr_of_buckets = 0;
+  map->nr_of_entries = 0;
+}
+
+static void
+grow(struct hikari_hash_map *map)
+{
+  size_t nr_of_buckets = map->nr_of_buckets == 0 ? INITIAL_NR_OF_BUCKETS
+                                                 : map->nr_of_buckets * 2;
+  struct hikari_hash_map_entry **buckets =
+      hikari_calloc(nr_of_buckets, sizeof(struct hikari_hash_map_entry *));
+
+  // chains are reversed before moving them over, this keeps shadowed entries
+  // behind the ones shadowing them
+  for (size_t i = 0; i < map->nr_of_buckets; i++) {
+    struct hikari_hash_map_entry *entry = map->buckets[i];
+    struct hikari_hash_map_entry *reversed = NULL;
+
+    while (entry != NULL) {
+      struct hikari_hash_map_entry *next = entry->next;
+      entry->next = reversed;
+      reversed = entry;
+      entry = next;
+    }
+
+    while (reversed != NULL) {
+      struct hikari_hash_map_entry *next = reversed->next;
+      size_t bucket = reversed->hash & (nr_of_buckets - 1);
+
+      reversed->next = buckets[bucket];
+      buckets[bucket] = reversed;
+      reversed = next;
+    }
+  }
+
+  hikari_free(map->buckets);
+
+  map->buckets = buckets;
+  map->nr_of_buckets = nr_of_buckets;
+}
+
+void
+hikari_hash_map_insert(struct hikari_hash_map *map,
+    struct hikari_hash_map_entry *entry,
+    const char *key)
+{
+  if (map->nr_of_entries >= map->nr_of_buckets / 4 * 3) {
+    grow(map);
+  }
+
+  entry->key = key;
+  entry->hash = hikari_hash_string(key);
+
+  size_t bucket = entry->hash & (map->nr_of_buckets - 1);
+  entry->next = map->buckets[bucket];
+  map->buckets[bucket] = entry;
+
+  map->nr_of_entries++;
+}
+
+void
+hikari_hash_map_remove(
+    struct hikari_hash_map *map, struct hikari_hash_map_entry *entry)
+{
+  assert(map->nr_of_buckets > 0);
+
+  struct hikari_hash_map_entry **cur =
+      &map->buckets[entry->hash & (map->nr_of_buckets - 1)];
+
+  while (*cur != entry) {
+    assert(*cur != NULL);
+    cur = &(*cur)->next;
+  }
+
+  *cur = entry->next;
+  entry->next = NULL;
+
+  map->nr_of_entries--;
+}
+
+struct hikari_hash_map_entry *
+hikari_hash_map_lookup(struct hikari_hash_map *map, const char *key)
+{
+  if (map->nr_of_entries == 0) {
+    return NULL;
+  }
+
+  uint32_t hash = hikari_hash_string(key);
+  struct hikari_hash_map_entry *entry =
+      map->buckets[hash & (map->nr_of_buckets - 1)];
+
+  while (entry != NULL) {
+    if (entry->hash == hash && !strcmp(entry->key, key)) {
+      return entry;
+    }
+    entry = entry->next;
+  }
+
+  return NULL;
+}
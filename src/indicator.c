@@ -3,6 +3,7 @@
 #include <wlr/render/wlr_renderer.h>
 
 #include <hikari/configuration.h>
+#include <hikari/latency.h>
 #include <hikari/mark.h>
 #include <hikari/renderer.h>
 #include <hikari/sheet.h>
@@ -120,6 +121,8 @@ hikari_indicator_damage(
   assert(indicator != NULL);
   assert(view != NULL);
 
+  hikari_latency_mark(HIKARI_LATENCY_INDICATOR);
+
   struct wlr_box *geometry = hikari_view_border_geometry(view);
   struct hikari_output *output = view->output;
 
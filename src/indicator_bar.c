@@ -13,6 +13,7 @@
 #include <hikari/configuration.h>
 #include <hikari/font.h>
 #include <hikari/indicator.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
@@ -45,6 +46,12 @@ hikari_indicator_bar_set_color(
 void
 hikari_indicator_bar_fini(struct hikari_indicator_bar *indicator_bar)
 {
+  if (indicator_bar->texture != NULL) {
+    hikari_memory_remove_texture(HIKARI_MEMORY_INDICATORS,
+        indicator_bar->texture->width,
+        indicator_bar->texture->height);
+  }
+
   wlr_texture_destroy(indicator_bar->texture);
   indicator_bar->texture = NULL;
   indicator_bar->cached_text[0] = '\0';
@@ -127,6 +134,10 @@ hikari_indicator_bar_update(struct hikari_indicator_bar *indicator_bar,
   indicator_bar->texture = wlr_texture_from_pixels(
       wlr_renderer, DRM_FORMAT_ARGB8888, stride, width, height, data);
 
+  if (indicator_bar->texture != NULL) {
+    hikari_memory_add_texture(HIKARI_MEMORY_INDICATORS, width, height);
+  }
+
   strncpy(indicator_bar->cached_text, text, sizeof(indicator_bar->cached_text) - 1);
   indicator_bar->cached_text[sizeof(indicator_bar->cached_text) - 1] = '\0';
 
@@ -13,6 +13,7 @@
 #include <hikari/configuration.h>
 #include <hikari/indicator_frame.h>
 #include <hikari/keyboard.h>
+#include <hikari/keymap.h>
 #include <hikari/normal_mode.h>
 #include <hikari/output.h>
 #include <hikari/renderer.h>
@@ -60,9 +61,10 @@ key_handler(
     struct hikari_keyboard *keyboard, struct wlr_keyboard_key_event *event)
 {
   struct hikari_workspace *workspace = hikari_server.workspace;
-  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED &&
+      keyboard->keymap != NULL) {
     uint32_t modifiers = hikari_server.keyboard_state.modifiers;
-    struct hikari_binding_group *bindings = &keyboard->bindings[modifiers];
+    struct hikari_binding_group *bindings = &keyboard->keymap->bindings[modifiers];
 
     if (handle_input(bindings, event->keycode)) {
       hikari_server_enter_normal_mode(NULL);
@@ -0,0 +1,523 @@
+#include <hikari/input_log.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <wlr/types/wlr_keyboard.h>
+#include <wlr/types/wlr_pointer.h>
+#include <wlr/types/wlr_switch.h>
+
+#ifdef HAVE_VIRTUAL_INPUT
+#include <wlr/backend.h>
+#include <wlr/interfaces/wlr_keyboard.h>
+#include <wlr/interfaces/wlr_pointer.h>
+#include <wlr/interfaces/wlr_switch.h>
+#include <wlr/types/wlr_output_layout.h>
+#endif
+
+#include <hikari/log.h>
+#include <hikari/memory.h>
+#include <hikari/server.h>
+
+#define INPUT_LOG_MAGIC "HKIL"
+#define INPUT_LOG_VERSION 1
+#define INPUT_LOG_MAX_NAME_LENGTH 255
+
+enum input_log_type {
+  INPUT_LOG_KEY,
+  INPUT_LOG_MOTION,
+  INPUT_LOG_BUTTON,
+  INPUT_LOG_AXIS,
+  INPUT_LOG_SWITCH
+};
+
+struct input_log_header {
+  char magic[4];
+  uint32_t version;
+};
+
+// records are written in host byte order, switch records are followed by
+// `length` bytes of device name, at most INPUT_LOG_MAX_NAME_LENGTH
+struct input_log_record {
+  uint32_t msec;
+  uint8_t type;
+  uint8_t state;
+  uint16_t source;
+  uint32_t code;
+  int32_t discrete;
+  union {
+    struct {
+      double x;
+      double y;
+    } position;
+    double delta;
+    uint32_t length;
+  };
+};
+
+struct input_log_event {
+  struct input_log_record record;
+  char *name;
+};
+
+#ifdef HAVE_VIRTUAL_INPUT
+struct replay_switch {
+  struct wl_list link;
+  struct wlr_switch wlr_switch;
+};
+
+static const struct wlr_keyboard_impl replay_keyboard_impl = {
+  .name = "hikari-replay-keyboard",
+};
+
+static const struct wlr_pointer_impl replay_pointer_impl = {
+  .name = "hikari-replay-pointer",
+};
+
+static const struct wlr_switch_impl replay_switch_impl = {
+  .name = "hikari-replay-switch",
+};
+#endif
+
+static struct {
+  FILE *record;
+  uint64_t record_start;
+
+  bool replay;
+  struct input_log_event *events;
+  size_t nevents;
+  size_t next;
+  uint64_t replay_start;
+  struct wl_event_source *timer;
+
+#ifdef HAVE_VIRTUAL_INPUT
+  bool devices;
+  struct wlr_keyboard keyboard;
+  struct wlr_pointer pointer;
+  struct wl_list switches;
+#endif
+} input_log = { .record = NULL, .replay = false, .events = NULL };
+
+static uint64_t
+now_msec(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+static void
+init_record(struct input_log_record *record, enum input_log_type type)
+{
+  // records are written as a whole, padding must not leak into the log
+  memset(record, 0, sizeof(struct input_log_record));
+  record->type = type;
+}
+
+static void
+write_record(struct input_log_record *record, const char *name)
+{
+  record->msec = now_msec() - input_log.record_start;
+
+  if (fwrite(record, sizeof(struct input_log_record), 1, input_log.record) !=
+          1 ||
+      (name != NULL &&
+          fwrite(name, 1, record->length, input_log.record) !=
+              record->length)) {
+    hikari_log_error("input log: could not write record, stopping");
+    fclose(input_log.record);
+    input_log.record = NULL;
+  }
+}
+
+bool
+hikari_input_log_record(const char *path)
+{
+  FILE *file = fopen(path, "w");
+
+  if (file == NULL) {
+    hikari_log_error("input log: could not open \"%s\" for recording", path);
+    return false;
+  }
+
+  struct input_log_header header = { .version = INPUT_LOG_VERSION };
+  memcpy(header.magic, INPUT_LOG_MAGIC, sizeof(header.magic));
+
+  if (fwrite(&header, sizeof(header), 1, file) != 1) {
+    hikari_log_error("input log: could not write \"%s\"", path);
+    fclose(file);
+    return false;
+  }
+
+  input_log.record = file;
+  input_log.record_start = now_msec();
+
+  return true;
+}
+
+static void
+free_events(void)
+{
+  for (size_t i = 0; i < input_log.nevents; i++) {
+    hikari_free(input_log.events[i].name);
+  }
+
+  hikari_free(input_log.events);
+  input_log.events = NULL;
+  input_log.nevents = 0;
+}
+
+bool
+hikari_input_log_replay(const char *path)
+{
+#ifdef HAVE_VIRTUAL_INPUT
+  bool success = false;
+  size_t capacity = 0;
+  FILE *file = fopen(path, "r");
+
+  if (file == NULL) {
+    hikari_log_error("input log: could not open \"%s\" for replay", path);
+    return false;
+  }
+
+  struct input_log_header header;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      memcmp(header.magic, INPUT_LOG_MAGIC, sizeof(header.magic)) != 0 ||
+      header.version != INPUT_LOG_VERSION) {
+    hikari_log_error("input log: \"%s\" is not an input log", path);
+    goto done;
+  }
+
+  struct input_log_record record;
+  while (fread(&record, sizeof(record), 1, file) == 1) {
+    char *name = NULL;
+
+    if (record.type > INPUT_LOG_SWITCH) {
+      hikari_log_error("input log: unknown record in \"%s\"", path);
+      goto done;
+    }
+
+    if (record.type == INPUT_LOG_SWITCH) {
+      if (record.length > INPUT_LOG_MAX_NAME_LENGTH) {
+        hikari_log_error("input log: invalid record in \"%s\"", path);
+        goto done;
+      }
+
+      name = hikari_malloc(record.length + 1);
+
+      if (fread(name, 1, record.length, file) != record.length) {
+        hikari_free(name);
+        hikari_log_error("input log: truncated record in \"%s\"", path);
+        goto done;
+      }
+
+      name[record.length] = '\0';
+    }
+
+    if (input_log.nevents == capacity) {
+      capacity = capacity == 0 ? 256 : capacity * 2;
+      input_log.events = hikari_realloc(
+          input_log.events, capacity * sizeof(struct input_log_event));
+    }
+
+    input_log.events[input_log.nevents].record = record;
+    input_log.events[input_log.nevents].name = name;
+    input_log.nevents++;
+  }
+
+  success = true;
+
+done:
+  fclose(file);
+
+  if (!success) {
+    free_events();
+  } else {
+    input_log.replay = true;
+    hikari_log_info(
+        "input log: loaded %zu events from \"%s\"", input_log.nevents, path);
+  }
+
+  return success;
+#else
+  hikari_log_error(
+      "input log: replaying \"%s\" requires virtual input support", path);
+  return false;
+#endif
+}
+
+#ifdef HAVE_VIRTUAL_INPUT
+static struct wlr_switch *
+find_switch(const char *name)
+{
+  struct replay_switch *replay_switch;
+  wl_list_for_each (replay_switch, &input_log.switches, link) {
+    if (!strcmp(replay_switch->wlr_switch.base.name, name)) {
+      return &replay_switch->wlr_switch;
+    }
+  }
+
+  replay_switch = hikari_malloc(sizeof(struct replay_switch));
+  wlr_switch_init(&replay_switch->wlr_switch, &replay_switch_impl, name);
+  wl_list_insert(&input_log.switches, &replay_switch->link);
+
+  wl_signal_emit_mutable(
+      &hikari_server.backend->events.new_input, &replay_switch->wlr_switch.base);
+
+  return &replay_switch->wlr_switch;
+}
+
+static void
+replay_event(struct input_log_event *event, uint32_t time_msec)
+{
+  struct input_log_record *record = &event->record;
+  struct wlr_pointer *pointer = &input_log.pointer;
+
+  switch (record->type) {
+    case INPUT_LOG_KEY: {
+      struct wlr_keyboard_key_event key_event = {
+        .time_msec = time_msec,
+        .keycode = record->code,
+        .update_state = true,
+        .state = record->state,
+      };
+
+      wlr_keyboard_notify_key(&input_log.keyboard, &key_event);
+    } break;
+
+    case INPUT_LOG_MOTION: {
+      struct wlr_box box;
+      wlr_output_layout_get_box(hikari_server.output_layout, NULL, &box);
+
+      if (wlr_box_empty(&box)) {
+        break;
+      }
+
+      struct wlr_pointer_motion_absolute_event motion_event = {
+        .pointer = pointer,
+        .time_msec = time_msec,
+        .x = (record->position.x - box.x) / box.width,
+        .y = (record->position.y - box.y) / box.height,
+      };
+
+      wl_signal_emit_mutable(&pointer->events.motion_absolute, &motion_event);
+      wl_signal_emit_mutable(&pointer->events.frame, pointer);
+    } break;
+
+    case INPUT_LOG_BUTTON: {
+      struct wlr_pointer_button_event button_event = {
+        .pointer = pointer,
+        .time_msec = time_msec,
+        .button = record->code,
+        .state = record->state,
+      };
+
+      wl_signal_emit_mutable(&pointer->events.button, &button_event);
+      wl_signal_emit_mutable(&pointer->events.frame, pointer);
+    } break;
+
+    case INPUT_LOG_AXIS: {
+      struct wlr_pointer_axis_event axis_event = {
+        .pointer = pointer,
+        .time_msec = time_msec,
+        .source = record->source,
+        .orientation = record->state,
+        .relative_direction = record->code,
+        .delta = record->delta,
+        .delta_discrete = record->discrete,
+      };
+
+      wl_signal_emit_mutable(&pointer->events.axis, &axis_event);
+      wl_signal_emit_mutable(&pointer->events.frame, pointer);
+    } break;
+
+    case INPUT_LOG_SWITCH: {
+      struct wlr_switch *wlr_switch = find_switch(event->name);
+      struct wlr_switch_toggle_event toggle_event = {
+        .time_msec = time_msec,
+        .switch_type = record->code,
+        .switch_state = record->state,
+      };
+
+      wl_signal_emit_mutable(&wlr_switch->events.toggle, &toggle_event);
+    } break;
+  }
+}
+
+static int
+replay_handler(void *data)
+{
+  (void)data;
+
+  uint64_t now = now_msec();
+  uint64_t elapsed = now - input_log.replay_start;
+
+  while (input_log.next < input_log.nevents &&
+         input_log.events[input_log.next].record.msec <= elapsed) {
+    replay_event(&input_log.events[input_log.next], (uint32_t)now);
+    input_log.next++;
+  }
+
+  if (input_log.next == input_log.nevents) {
+    hikari_log_info("input log: replay finished after %lums",
+        (unsigned long)elapsed);
+    hikari_server_terminate(NULL);
+    return 0;
+  }
+
+  wl_event_source_timer_update(input_log.timer,
+      input_log.events[input_log.next].record.msec - elapsed);
+
+  return 0;
+}
+#endif
+
+void
+hikari_input_log_start(void)
+{
+#ifdef HAVE_VIRTUAL_INPUT
+  if (!input_log.replay) {
+    return;
+  }
+
+  if (input_log.nevents == 0) {
+    hikari_log_info("input log: nothing to replay");
+    hikari_server_terminate(NULL);
+    return;
+  }
+
+  wl_list_init(&input_log.switches);
+
+  wlr_keyboard_init(
+      &input_log.keyboard, &replay_keyboard_impl, replay_keyboard_impl.name);
+  wlr_pointer_init(
+      &input_log.pointer, &replay_pointer_impl, replay_pointer_impl.name);
+  input_log.devices = true;
+
+  struct wl_signal *new_input = &hikari_server.backend->events.new_input;
+  wl_signal_emit_mutable(new_input, &input_log.keyboard.base);
+  wl_signal_emit_mutable(new_input, &input_log.pointer.base);
+
+  input_log.next = 0;
+  input_log.replay_start = now_msec();
+  input_log.timer = wl_event_loop_add_timer(
+      hikari_server.event_loop, replay_handler, NULL);
+
+  replay_handler(NULL);
+#endif
+}
+
+void
+hikari_input_log_fini(void)
+{
+  if (input_log.record != NULL) {
+    fclose(input_log.record);
+    input_log.record = NULL;
+  }
+
+#ifdef HAVE_VIRTUAL_INPUT
+  if (input_log.timer != NULL) {
+    wl_event_source_remove(input_log.timer);
+    input_log.timer = NULL;
+  }
+
+  if (input_log.devices) {
+    struct replay_switch *replay_switch, *replay_switch_temp;
+    wl_list_for_each_safe (
+        replay_switch, replay_switch_temp, &input_log.switches, link) {
+      wl_list_remove(&replay_switch->link);
+      wlr_switch_finish(&replay_switch->wlr_switch);
+      hikari_free(replay_switch);
+    }
+
+    wlr_pointer_finish(&input_log.pointer);
+    wlr_keyboard_finish(&input_log.keyboard);
+    input_log.devices = false;
+  }
+#endif
+
+  free_events();
+  input_log.replay = false;
+}
+
+void
+hikari_input_log_key(struct wlr_keyboard_key_event *event)
+{
+  if (input_log.record == NULL) {
+    return;
+  }
+
+  struct input_log_record record;
+  init_record(&record, INPUT_LOG_KEY);
+  record.state = event->state;
+  record.code = event->keycode;
+
+  write_record(&record, NULL);
+}
+
+void
+hikari_input_log_motion(double x, double y)
+{
+  if (input_log.record == NULL) {
+    return;
+  }
+
+  struct input_log_record record;
+  init_record(&record, INPUT_LOG_MOTION);
+  record.position.x = x;
+  record.position.y = y;
+
+  write_record(&record, NULL);
+}
+
+void
+hikari_input_log_button(struct wlr_pointer_button_event *event)
+{
+  if (input_log.record == NULL) {
+    return;
+  }
+
+  struct input_log_record record;
+  init_record(&record, INPUT_LOG_BUTTON);
+  record.state = event->state;
+  record.code = event->button;
+
+  write_record(&record, NULL);
+}
+
+void
+hikari_input_log_axis(struct wlr_pointer_axis_event *event)
+{
+  if (input_log.record == NULL) {
+    return;
+  }
+
+  struct input_log_record record;
+  init_record(&record, INPUT_LOG_AXIS);
+  record.state = event->orientation;
+  record.source = event->source;
+  record.code = event->relative_direction;
+  record.discrete = event->delta_discrete;
+  record.delta = event->delta;
+
+  write_record(&record, NULL);
+}
+
+void
+hikari_input_log_switch(const char *name, struct wlr_switch_toggle_event *event)
+{
+  if (input_log.record == NULL) {
+    return;
+  }
+
+  struct input_log_record record;
+  init_record(&record, INPUT_LOG_SWITCH);
+  record.state = event->switch_state;
+  record.code = event->switch_type;
+  record.length = strnlen(name, INPUT_LOG_MAX_NAME_LENGTH);
+
+  write_record(&record, name);
+}
@@ -1,6 +1,7 @@
 #include <hikari/input_method_relay.h>
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <wlr/types/wlr_input_method_v2.h>
 #include <wlr/types/wlr_text_input_v3.h>
@@ -8,6 +9,7 @@
 #include <wlr/types/wlr_compositor.h>
 
 #include <hikari/log.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
 #include <hikari/view.h>
@@ -149,7 +151,7 @@ handle_popup_destroy(struct wl_listener *listener, void *data)
   wl_list_remove(&popup->surface_map.link);
   wl_list_remove(&popup->surface_unmap.link);
   wl_list_remove(&popup->link);
-  free(popup);
+  hikari_pool_free(HIKARI_POOL_INPUT_POPUP, popup);
 }
 
 static void
@@ -161,10 +163,9 @@ handle_im_new_popup(struct wl_listener *listener, void *data)
 
   hikari_log_debug("new popup surface created");
 
-  struct hikari_input_popup *popup = calloc(1, sizeof(*popup));
-  if (popup == NULL) {
-    return;
-  }
+  struct hikari_input_popup *popup =
+      hikari_pool_alloc(HIKARI_POOL_INPUT_POPUP, sizeof(*popup));
+  memset(popup, 0, sizeof(*popup));
 
   popup->popup = wlr_popup;
   popup->relay = relay;
@@ -252,7 +253,7 @@ handle_text_input_destroy(struct wl_listener *listener, void *data)
   wl_list_remove(&text_input->disable.link);
   wl_list_remove(&text_input->destroy.link);
   wl_list_remove(&text_input->link);
-  free(text_input);
+  hikari_tagged_free(text_input);
 }
 
 static void
@@ -264,10 +265,8 @@ handle_new_text_input(struct wl_listener *listener, void *data)
 
   hikari_log_debug("new text_input created by client");
 
-  struct hikari_text_input *text_input = calloc(1, sizeof(*text_input));
-  if (text_input == NULL) {
-    return;
-  }
+  struct hikari_text_input *text_input =
+      hikari_tagged_calloc(HIKARI_MEMORY_INPUT, 1, sizeof(*text_input));
 
   text_input->input = wlr_text_input;
   text_input->relay = relay;
@@ -4,9 +4,11 @@
 #include <wlr/types/wlr_keyboard.h>
 #include <wlr/types/wlr_seat.h>
 
-#include <hikari/binding.h>
-#include <hikari/binding_config.h>
+#include <hikari/input_log.h>
 #include <hikari/keyboard_config.h>
+#include <hikari/keymap.h>
+#include <hikari/latency.h>
+#include <hikari/log.h>
 #include <hikari/memory.h>
 #include <hikari/mode.h>
 #include <hikari/server.h>
@@ -32,7 +34,11 @@ key_handler(struct wl_listener *listener, void *data)
   struct hikari_keyboard *keyboard = wl_container_of(listener, keyboard, key);
   struct wlr_keyboard_key_event *event = data;
 
+  hikari_input_log_key(event);
+
+  hikari_latency_input_begin();
   hikari_server.mode->key_handler(keyboard, event);
+  hikari_latency_input_end();
 }
 
 static void
@@ -44,7 +50,9 @@ modifiers_handler(struct wl_listener *listener, void *data)
 
   update_mod_state(keyboard);
 
+  hikari_latency_input_begin();
   hikari_server.mode->modifiers_handler(keyboard);
+  hikari_latency_input_end();
 }
 
 static void
@@ -55,7 +63,7 @@ destroy_handler(struct wl_listener *listener, void *data)
       wl_container_of(listener, keyboard, destroy);
 
   hikari_keyboard_fini(keyboard);
-  hikari_free(keyboard);
+  hikari_tagged_free(keyboard);
 
   uint32_t caps = WL_SEAT_CAPABILITY_POINTER;
   if (!wl_list_empty(&hikari_server.keyboards)) {
@@ -64,81 +72,6 @@ destroy_handler(struct wl_listener *listener, void *data)
   wlr_seat_set_capabilities(hikari_server.seat, caps);
 }
 
-struct keycode_matcher_state {
-  xkb_keysym_t keysym;
-  uint32_t *keycode;
-  struct xkb_state *state;
-};
-
-static void
-match_keycode(struct xkb_keymap *keymap, xkb_keycode_t key, void *data)
-{
-  (void)keymap;
-  struct keycode_matcher_state *matcher_state = data;
-  xkb_keysym_t keysym = xkb_state_key_get_one_sym(matcher_state->state, key);
-
-  if (keysym != XKB_KEY_NoSymbol && keysym == matcher_state->keysym &&
-      *(matcher_state->keycode) == 0) {
-    *(matcher_state->keycode) = key - 8;
-  }
-}
-
-static void
-resolve_keysym(uint32_t *keycode, struct xkb_state *state, xkb_keysym_t keysym)
-{
-  struct keycode_matcher_state matcher_state = { keysym, keycode, state };
-
-  xkb_keymap_key_for_each(
-      xkb_state_get_keymap(state), match_keycode, &matcher_state);
-}
-
-static void
-configure_bindings(struct hikari_keyboard *keyboard, struct wl_list *bindings)
-{
-  int nr[256] = { 0 };
-  struct hikari_binding_config *binding_config;
-  wl_list_for_each (binding_config, bindings, link) {
-    nr[binding_config->key.modifiers]++;
-  }
-
-  for (int mask = 0; mask < 256; mask++) {
-    keyboard->bindings[mask].nbindings = nr[mask];
-    if (nr[mask] != 0) {
-      keyboard->bindings[mask].bindings =
-          hikari_calloc(nr[mask], sizeof(struct hikari_binding));
-    } else {
-      keyboard->bindings[mask].bindings = NULL;
-    }
-
-    nr[mask] = 0;
-  }
-
-  struct xkb_state *state = xkb_state_new(keyboard->keymap);
-
-  wl_list_for_each (binding_config, bindings, link) {
-    uint8_t mask = binding_config->key.modifiers;
-    struct hikari_binding *binding =
-        &keyboard->bindings[mask].bindings[nr[mask]];
-
-    binding->action = &binding_config->action;
-
-    switch (binding_config->key.type) {
-      case HIKARI_ACTION_BINDING_KEY_KEYCODE:
-        binding->keycode = binding_config->key.value.keycode;
-        break;
-
-      case HIKARI_ACTION_BINDING_KEY_KEYSYM:
-        resolve_keysym(
-            &binding->keycode, state, binding_config->key.value.keysym);
-        break;
-    }
-
-    nr[mask]++;
-  }
-
-  xkb_state_unref(state);
-}
-
 void
 hikari_keyboard_init(
     struct hikari_keyboard *keyboard, struct wlr_input_device *device)
@@ -160,8 +93,6 @@ hikari_keyboard_init(
   wlr_seat_set_keyboard(hikari_server.seat, keyboard->keyboard);
 
   wl_list_insert(&hikari_server.keyboards, &keyboard->server_keyboards);
-
-  hikari_binding_group_init(keyboard->bindings);
 }
 
 void
@@ -173,35 +104,46 @@ hikari_keyboard_fini(struct hikari_keyboard *keyboard)
 
   wl_list_remove(&keyboard->server_keyboards);
 
-  xkb_keymap_unref(keyboard->keymap);
-  hikari_binding_group_fini(keyboard->bindings);
+  hikari_keymap_release(keyboard->keymap);
 }
 
 static struct xkb_keymap *
-load_keymap(struct hikari_keyboard_config *keyboard_config)
+load_keymap(struct hikari_keyboard *keyboard,
+    struct hikari_keyboard_config *keyboard_config)
 {
-  struct xkb_keymap *keymap = NULL;
-
-  switch (keyboard_config->xkb.type) {
-    case HIKARI_XKB_TYPE_RULES:
-      hikari_keyboard_config_compile_keymap(keyboard_config);
-      keymap = xkb_keymap_ref(keyboard_config->xkb.value.keymap);
-      break;
-    case HIKARI_XKB_TYPE_KEYMAP:
-      keymap = xkb_keymap_ref(keyboard_config->xkb.value.keymap);
-      break;
+  if (hikari_keyboard_config_compile_keymap(keyboard_config)) {
+    return keyboard_config->xkb.value.keymap;
+  }
+
+  hikari_log_error("failed to compile keymap for \"%s\"",
+      keyboard->device->name);
+
+  // never borrow the keymap of another keyboard, it might have a different
+  // layout
+  if (keyboard->keymap != NULL) {
+    return keyboard->keymap->keymap;
   }
 
-  return keymap;
+  return NULL;
 }
 
 void
 hikari_keyboard_configure(struct hikari_keyboard *keyboard,
-    struct hikari_keyboard_config *keyboard_config)
+    struct hikari_keyboard_config *keyboard_config,
+    struct wl_list *bindings)
 {
-  keyboard->keymap = load_keymap(keyboard_config);
-  assert(keyboard->keymap != NULL);
-  wlr_keyboard_set_keymap(keyboard->keyboard, keyboard->keymap);
+  struct xkb_keymap *xkb_keymap = load_keymap(keyboard, keyboard_config);
+
+  if (xkb_keymap != NULL) {
+    struct hikari_keymap *keymap = hikari_keymap_acquire(xkb_keymap, bindings);
+
+    if (keymap != keyboard->keymap) {
+      wlr_keyboard_set_keymap(keyboard->keyboard, keymap->keymap);
+    }
+
+    hikari_keymap_release(keyboard->keymap);
+    keyboard->keymap = keymap;
+  }
 
   int repeat_rate = hikari_keyboard_config_get_repeat_rate(keyboard_config);
   int repeat_delay = hikari_keyboard_config_get_repeat_delay(keyboard_config);
@@ -210,16 +152,6 @@ hikari_keyboard_configure(struct hikari_keyboard *keyboard,
       keyboard->keyboard, repeat_rate, repeat_delay);
 }
 
-void
-hikari_keyboard_configure_bindings(
-    struct hikari_keyboard *keyboard, struct wl_list *bindings)
-{
-  hikari_binding_group_fini(keyboard->bindings);
-  hikari_binding_group_init(keyboard->bindings);
-
-  configure_bindings(keyboard, bindings);
-}
-
 void
 hikari_keyboard_for_keysym(struct hikari_keyboard *keyboard,
     uint32_t keycode,
@@ -4,6 +4,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <hikari/keymap_cache.h>
 #include <hikari/log.h>
 
 #define HIKARI_KEYBOARD_CONFIG_DEFAULT_REPEAT_RATE 25
@@ -108,7 +109,7 @@ load_xkb_file(struct hikari_xkb *xkb, const char *xkb_file)
     goto done;
   }
 
-  xkb->type = HIKARI_XKB_TYPE_RULES;
+  xkb->type = HIKARI_XKB_TYPE_KEYMAP;
   xkb->value.keymap = keymap;
 
   success = true;
@@ -194,6 +195,8 @@ xkb_init(struct hikari_xkb_config *xkb_config)
   hikari_xkb_config_init_layout(xkb_config, NULL);
   hikari_xkb_config_init_variant(xkb_config, NULL);
   hikari_xkb_config_init_options(xkb_config, NULL);
+
+  xkb_config->keymap = NULL;
 }
 
 void
@@ -224,6 +227,8 @@ xkb_fini(struct hikari_xkb_config *xkb_config)
   free(xkb_config->layout.value);
   free(xkb_config->variant.value);
   free(xkb_config->options.value);
+
+  xkb_keymap_unref(xkb_config->keymap);
 }
 
 void
@@ -336,23 +341,34 @@ hikari_keyboard_config_merge(struct hikari_keyboard_config *keyboard_config,
 }
 #undef MERGE
 
-static struct xkb_keymap *
-compile_keymap(struct hikari_xkb_config *xkb_config)
+static void
+use_keymap(
+    struct hikari_keyboard_config *keyboard_config, struct xkb_keymap *keymap)
 {
-  struct xkb_rule_names rules = { 0 };
+  xkb_keymap_ref(keymap);
+  xkb_fini(&keyboard_config->xkb.value.rules);
 
-  rules.rules = xkb_config->rules.value;
-  rules.model = xkb_config->model.value;
-  rules.layout = xkb_config->layout.value;
-  rules.variant = xkb_config->variant.value;
-  rules.options = xkb_config->options.value;
+  keyboard_config->xkb.type = HIKARI_XKB_TYPE_KEYMAP;
+  keyboard_config->xkb.value.keymap = keymap;
+}
 
-  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
-  struct xkb_keymap *keymap =
-      xkb_map_new_from_names(context, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
-  xkb_context_unref(context);
+bool
+hikari_keyboard_config_build_keymap(
+    struct hikari_keyboard_config *keyboard_config, struct xkb_context *context)
+{
+  if (keyboard_config->xkb.type == HIKARI_XKB_TYPE_KEYMAP) {
+    return true;
+  }
+
+  assert(keyboard_config->xkb.type == HIKARI_XKB_TYPE_RULES);
+
+  struct hikari_xkb_config *xkb_config = &keyboard_config->xkb.value.rules;
 
-  return keymap;
+  if (xkb_config->keymap == NULL) {
+    xkb_config->keymap = hikari_keymap_cache_build(context, xkb_config);
+  }
+
+  return xkb_config->keymap != NULL;
 }
 
 bool
@@ -365,16 +381,20 @@ hikari_keyboard_config_compile_keymap(
 
   assert(keyboard_config->xkb.type == HIKARI_XKB_TYPE_RULES);
 
-  struct xkb_keymap *keymap = compile_keymap(&keyboard_config->xkb.value.rules);
+  struct hikari_xkb_config *xkb_config = &keyboard_config->xkb.value.rules;
+  struct xkb_keymap *keymap;
+
+  if (xkb_config->keymap != NULL) {
+    keymap = hikari_keymap_cache_insert(xkb_config, xkb_config->keymap);
+  } else {
+    keymap = hikari_keymap_cache_compile(xkb_config);
+  }
 
   if (keymap == NULL) {
     return false;
   }
 
-  xkb_fini(&keyboard_config->xkb.value.rules);
-
-  keyboard_config->xkb.type = HIKARI_XKB_TYPE_KEYMAP;
-  keyboard_config->xkb.value.keymap = keymap;
+  use_keymap(keyboard_config, keymap);
 
   return true;
 }
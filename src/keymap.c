@@ -0,0 +1,158 @@
+#include <hikari/keymap.h>
+
+#include <assert.h>
+
+#include <hikari/binding.h>
+#include <hikari/binding_config.h>
+#include <hikari/memory.h>
+#include <hikari/server.h>
+
+struct keycode_matcher_state {
+  xkb_keysym_t keysym;
+  uint32_t *keycode;
+  struct xkb_state *state;
+};
+
+static void
+match_keycode(struct xkb_keymap *keymap, xkb_keycode_t key, void *data)
+{
+  (void)keymap;
+  struct keycode_matcher_state *matcher_state = data;
+  xkb_keysym_t keysym = xkb_state_key_get_one_sym(matcher_state->state, key);
+
+  if (keysym != XKB_KEY_NoSymbol && keysym == matcher_state->keysym &&
+      *(matcher_state->keycode) == 0) {
+    *(matcher_state->keycode) = key - 8;
+  }
+}
+
+static void
+resolve_keysym(uint32_t *keycode, struct xkb_state *state, xkb_keysym_t keysym)
+{
+  struct keycode_matcher_state matcher_state = { keysym, keycode, state };
+
+  xkb_keymap_key_for_each(
+      xkb_state_get_keymap(state), match_keycode, &matcher_state);
+}
+
+static void
+configure_bindings(struct hikari_keymap *keymap, struct wl_list *bindings)
+{
+  int nr[256] = { 0 };
+  struct hikari_binding_config *binding_config;
+  wl_list_for_each (binding_config, bindings, link) {
+    nr[binding_config->key.modifiers]++;
+  }
+
+  for (int mask = 0; mask < 256; mask++) {
+    keymap->bindings[mask].nbindings = nr[mask];
+    if (nr[mask] != 0) {
+      keymap->bindings[mask].bindings =
+          hikari_calloc(nr[mask], sizeof(struct hikari_binding));
+    } else {
+      keymap->bindings[mask].bindings = NULL;
+    }
+
+    nr[mask] = 0;
+  }
+
+  struct xkb_state *state = xkb_state_new(keymap->keymap);
+
+  wl_list_for_each (binding_config, bindings, link) {
+    uint8_t mask = binding_config->key.modifiers;
+    struct hikari_binding *binding =
+        &keymap->bindings[mask].bindings[nr[mask]];
+
+    binding->action = &binding_config->action;
+
+    switch (binding_config->key.type) {
+      case HIKARI_ACTION_BINDING_KEY_KEYCODE:
+        binding->keycode = binding_config->key.value.keycode;
+        break;
+
+      case HIKARI_ACTION_BINDING_KEY_KEYSYM:
+        resolve_keysym(
+            &binding->keycode, state, binding_config->key.value.keysym);
+        break;
+    }
+
+    nr[mask]++;
+  }
+
+  xkb_state_unref(state);
+}
+
+static struct hikari_keymap *
+find_keymap(struct xkb_keymap *xkb_keymap, struct wl_list *binding_configs)
+{
+  struct hikari_keymap *keymap;
+  wl_list_for_each (keymap, &hikari_server.keymaps, server_keymaps) {
+    if (keymap->keymap == xkb_keymap &&
+        keymap->binding_configs == binding_configs) {
+      return keymap;
+    }
+  }
+
+  return NULL;
+}
+
+struct hikari_keymap *
+hikari_keymap_acquire(
+    struct xkb_keymap *xkb_keymap, struct wl_list *binding_configs)
+{
+  assert(xkb_keymap != NULL);
+
+  struct hikari_keymap *keymap = find_keymap(xkb_keymap, binding_configs);
+
+  if (keymap != NULL) {
+    keymap->refcount++;
+    return keymap;
+  }
+
+  keymap = hikari_malloc(sizeof(struct hikari_keymap));
+
+  keymap->refcount = 1;
+  keymap->keymap = xkb_keymap_ref(xkb_keymap);
+  keymap->binding_configs = binding_configs;
+
+  hikari_binding_group_init(keymap->bindings);
+  configure_bindings(keymap, binding_configs);
+
+  wl_list_insert(&hikari_server.keymaps, &keymap->server_keymaps);
+
+  return keymap;
+}
+
+void
+hikari_keymap_release(struct hikari_keymap *keymap)
+{
+  if (keymap == NULL) {
+    return;
+  }
+
+  assert(keymap->refcount > 0);
+
+  if (--keymap->refcount > 0) {
+    return;
+  }
+
+  wl_list_remove(&keymap->server_keymaps);
+
+  hikari_binding_group_fini(keymap->bindings);
+  xkb_keymap_unref(keymap->keymap);
+
+  hikari_free(keymap);
+}
+
+void
+hikari_keymap_invalidate(struct wl_list *binding_configs)
+{
+  struct hikari_keymap *keymap;
+  wl_list_for_each (keymap, &hikari_server.keymaps, server_keymaps) {
+    if (keymap->binding_configs == binding_configs) {
+      // keyboards hold on to this keymap until they get reconfigured, make
+      // sure it is not handed out for the replaced bindings again
+      keymap->binding_configs = NULL;
+    }
+  }
+}
@@ -0,0 +1,196 @@
+#include <hikari/keymap_cache.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <hikari/keyboard_config.h>
+#include <hikari/memory.h>
+
+// Keymaps are cached by their RMLVO names so keyboards that share a layout,
+// and layouts that survive a reload, keep using the very same keymap. The cache
+// is owned by the event loop, only hikari_keymap_cache_build may be called
+// from other threads.
+
+enum { RULES, MODEL, LAYOUT, VARIANT, OPTIONS, NR_OF_NAMES };
+
+struct keymap_cache_entry {
+  struct wl_list link;
+
+  char *names[NR_OF_NAMES];
+
+  struct xkb_keymap *keymap;
+};
+
+static struct {
+  struct wl_list entries;
+} keymap_cache;
+
+static void
+get_names(struct hikari_xkb_config *xkb_config, const char **names)
+{
+  names[RULES] = xkb_config->rules.value;
+  names[MODEL] = xkb_config->model.value;
+  names[LAYOUT] = xkb_config->layout.value;
+  names[VARIANT] = xkb_config->variant.value;
+  names[OPTIONS] = xkb_config->options.value;
+}
+
+static bool
+name_equals(const char *a, const char *b)
+{
+  if (a == NULL || b == NULL) {
+    return a == b;
+  }
+
+  return !strcmp(a, b);
+}
+
+static struct keymap_cache_entry *
+find_entry(struct hikari_xkb_config *xkb_config)
+{
+  const char *names[NR_OF_NAMES];
+  get_names(xkb_config, names);
+
+  struct keymap_cache_entry *entry;
+  wl_list_for_each (entry, &keymap_cache.entries, link) {
+    bool found = true;
+    for (int i = 0; i < NR_OF_NAMES && found; i++) {
+      found = name_equals(entry->names[i], names[i]);
+    }
+
+    if (found) {
+      return entry;
+    }
+  }
+
+  return NULL;
+}
+
+static struct keymap_cache_entry *
+create_entry(struct hikari_xkb_config *xkb_config, struct xkb_keymap *keymap)
+{
+  const char *names[NR_OF_NAMES];
+  get_names(xkb_config, names);
+
+  struct keymap_cache_entry *entry =
+      hikari_malloc(sizeof(struct keymap_cache_entry));
+
+  for (int i = 0; i < NR_OF_NAMES; i++) {
+    entry->names[i] = names[i] != NULL ? strdup(names[i]) : NULL;
+  }
+
+  entry->keymap = keymap;
+
+  wl_list_insert(&keymap_cache.entries, &entry->link);
+
+  return entry;
+}
+
+static void
+destroy_entry(struct keymap_cache_entry *entry)
+{
+  wl_list_remove(&entry->link);
+
+  for (int i = 0; i < NR_OF_NAMES; i++) {
+    free(entry->names[i]);
+  }
+
+  xkb_keymap_unref(entry->keymap);
+  hikari_free(entry);
+}
+
+void
+hikari_keymap_cache_init(void)
+{
+  wl_list_init(&keymap_cache.entries);
+}
+
+void
+hikari_keymap_cache_fini(void)
+{
+  struct keymap_cache_entry *entry, *entry_temp;
+  wl_list_for_each_safe (entry, entry_temp, &keymap_cache.entries, link) {
+    destroy_entry(entry);
+  }
+}
+
+struct xkb_keymap *
+hikari_keymap_cache_build(
+    struct xkb_context *context, struct hikari_xkb_config *xkb_config)
+{
+  struct xkb_rule_names rules = { 0 };
+
+  rules.rules = xkb_config->rules.value;
+  rules.model = xkb_config->model.value;
+  rules.layout = xkb_config->layout.value;
+  rules.variant = xkb_config->variant.value;
+  rules.options = xkb_config->options.value;
+
+  return xkb_map_new_from_names(context, &rules, XKB_KEYMAP_COMPILE_NO_FLAGS);
+}
+
+struct xkb_keymap *
+hikari_keymap_cache_compile(struct hikari_xkb_config *xkb_config)
+{
+  struct keymap_cache_entry *entry = find_entry(xkb_config);
+
+  if (entry != NULL) {
+    return entry->keymap;
+  }
+
+  struct xkb_context *context = xkb_context_new(XKB_CONTEXT_NO_FLAGS);
+  struct xkb_keymap *keymap = hikari_keymap_cache_build(context, xkb_config);
+  xkb_context_unref(context);
+
+  if (keymap == NULL) {
+    return NULL;
+  }
+
+  create_entry(xkb_config, keymap);
+
+  return keymap;
+}
+
+struct xkb_keymap *
+hikari_keymap_cache_insert(
+    struct hikari_xkb_config *xkb_config, struct xkb_keymap *keymap)
+{
+  struct keymap_cache_entry *entry = find_entry(xkb_config);
+
+  // an equal keymap is already in use, hand that one out instead so
+  // keyboards do not switch keymaps for nothing
+  if (entry != NULL) {
+    return entry->keymap;
+  }
+
+  create_entry(xkb_config, xkb_keymap_ref(keymap));
+
+  return keymap;
+}
+
+static bool
+is_used(struct keymap_cache_entry *entry, struct wl_list *keyboard_configs)
+{
+  struct hikari_keyboard_config *keyboard_config;
+  wl_list_for_each (keyboard_config, keyboard_configs, link) {
+    if (keyboard_config->xkb.type == HIKARI_XKB_TYPE_KEYMAP &&
+        keyboard_config->xkb.value.keymap == entry->keymap) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// keyboards hold their own reference to the keymap they are using, dropping
+// an entry only stops it from being handed out again
+void
+hikari_keymap_cache_sweep(struct wl_list *keyboard_configs)
+{
+  struct keymap_cache_entry *entry, *entry_temp;
+  wl_list_for_each_safe (entry, entry_temp, &keymap_cache.entries, link) {
+    if (!is_used(entry, keyboard_configs)) {
+      destroy_entry(entry);
+    }
+  }
+}
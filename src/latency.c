@@ -0,0 +1,267 @@
+#include <hikari/latency.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <wlr/types/wlr_output.h>
+
+#include <hikari/log.h>
+#include <hikari/output.h>
+#include <hikari/server.h>
+
+#define REPORT_INTERVAL 256
+
+static const char *kind_names[] = {
+  [HIKARI_LATENCY_OTHER] = "other",
+  [HIKARI_LATENCY_MOVE] = "move",
+  [HIKARI_LATENCY_RESIZE] = "resize",
+  [HIKARI_LATENCY_FOCUS] = "focus",
+  [HIKARI_LATENCY_INDICATOR] = "indicator",
+};
+
+static struct {
+  bool enabled;
+  int depth;
+  unsigned long seq;
+  struct hikari_latency_tag tag;
+} input_state = { .enabled = false };
+
+static uint64_t
+timespec_to_nsec(const struct timespec *ts)
+{
+  return (uint64_t)ts->tv_sec * 1000000000 + ts->tv_nsec;
+}
+
+static uint64_t
+now_nsec(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return timespec_to_nsec(&now);
+}
+
+static int
+compare_samples(const void *a, const void *b)
+{
+  uint32_t x = *(const uint32_t *)a;
+  uint32_t y = *(const uint32_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static double
+percentile(uint32_t *sorted, int nsamples, int p)
+{
+  int index = (nsamples - 1) * p / 100;
+
+  return sorted[index] / 1000.0;
+}
+
+static void
+report(struct hikari_latency *latency, enum hikari_latency_kind kind)
+{
+  struct hikari_latency_samples *samples = &latency->samples[kind];
+  int nsamples = samples->nsamples;
+
+  if (nsamples == 0) {
+    return;
+  }
+
+  uint32_t sorted[HIKARI_LATENCY_NR_OF_SAMPLES];
+  memcpy(sorted, samples->usec, nsamples * sizeof(uint32_t));
+  qsort(sorted, nsamples, sizeof(uint32_t), compare_samples);
+
+  hikari_log_info("latency: output=%s kind=%s total=%lu window=%d "
+                  "p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms",
+      latency->wlr_output->name,
+      kind_names[kind],
+      samples->total,
+      nsamples,
+      percentile(sorted, nsamples, 50),
+      percentile(sorted, nsamples, 90),
+      percentile(sorted, nsamples, 99),
+      sorted[nsamples - 1] / 1000.0);
+}
+
+static void
+add_sample(struct hikari_latency *latency,
+    enum hikari_latency_kind kind,
+    uint64_t nsec)
+{
+  struct hikari_latency_samples *samples = &latency->samples[kind];
+  uint64_t usec = nsec / 1000;
+
+  samples->usec[samples->next] = usec > UINT32_MAX ? UINT32_MAX : usec;
+  samples->next = (samples->next + 1) % HIKARI_LATENCY_NR_OF_SAMPLES;
+  samples->total++;
+
+  if (samples->nsamples < HIKARI_LATENCY_NR_OF_SAMPLES) {
+    samples->nsamples++;
+  }
+
+  if (samples->total % REPORT_INTERVAL == 0) {
+    report(latency, kind);
+  }
+}
+
+static void
+present_handler(struct wl_listener *listener, void *data)
+{
+  struct hikari_latency *latency =
+      wl_container_of(listener, latency, present);
+  struct wlr_output_event_present *event = data;
+
+  if (!latency->committed) {
+    return;
+  }
+
+  latency->committed = false;
+
+  if (!event->presented) {
+    latency->pending.input_nsec = 0;
+    return;
+  }
+
+  uint64_t presented_nsec = timespec_to_nsec(&event->when);
+  if (presented_nsec == 0) {
+    presented_nsec = now_nsec();
+  }
+
+  uint64_t input_nsec = latency->pending.input_nsec;
+  latency->pending.input_nsec = 0;
+
+  if (presented_nsec >= input_nsec) {
+    add_sample(latency, latency->pending.kind, presented_nsec - input_nsec);
+  }
+}
+
+void
+hikari_latency_enable(void)
+{
+  input_state.enabled = true;
+}
+
+void
+hikari_latency_init(
+    struct hikari_latency *latency, struct wlr_output *wlr_output)
+{
+  memset(latency, 0, sizeof(struct hikari_latency));
+
+  latency->wlr_output = wlr_output;
+
+  if (input_state.enabled) {
+    latency->present.notify = present_handler;
+    wl_signal_add(&wlr_output->events.present, &latency->present);
+  } else {
+    wl_list_init(&latency->present.link);
+  }
+}
+
+void
+hikari_latency_fini(struct hikari_latency *latency)
+{
+  wl_list_remove(&latency->present.link);
+
+  for (int kind = 0; kind < HIKARI_LATENCY_NR_OF_KINDS; kind++) {
+    report(latency, kind);
+  }
+}
+
+void
+hikari_latency_input_begin(void)
+{
+  if (!input_state.enabled) {
+    return;
+  }
+
+  if (input_state.depth++ == 0) {
+    input_state.seq++;
+    input_state.tag.input_nsec = now_nsec();
+    input_state.tag.kind = HIKARI_LATENCY_OTHER;
+  }
+}
+
+void
+hikari_latency_input_end(void)
+{
+  if (!input_state.enabled || --input_state.depth > 0) {
+    return;
+  }
+
+  // the kind of change is only known once the input has been handled
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    struct hikari_latency *latency = &output->latency;
+
+    if (latency->pending_seq == input_state.seq) {
+      latency->pending.kind = input_state.tag.kind;
+    }
+  }
+
+  input_state.tag.input_nsec = 0;
+}
+
+bool
+hikari_latency_resume(struct hikari_latency_tag *tag)
+{
+  // changes that are applied while input is handled belong to that input
+  if (!input_state.enabled || input_state.depth > 0 ||
+      tag->input_nsec == 0) {
+    return false;
+  }
+
+  input_state.depth++;
+  input_state.seq++;
+  input_state.tag = *tag;
+
+  return true;
+}
+
+void
+hikari_latency_suspend(void)
+{
+  hikari_latency_input_end();
+}
+
+void
+hikari_latency_save(struct hikari_latency_tag *tag)
+{
+  if (input_state.depth > 0) {
+    *tag = input_state.tag;
+  } else {
+    tag->input_nsec = 0;
+    tag->kind = HIKARI_LATENCY_OTHER;
+  }
+}
+
+void
+hikari_latency_mark(enum hikari_latency_kind kind)
+{
+  if (input_state.depth > 0 && input_state.tag.kind == HIKARI_LATENCY_OTHER) {
+    input_state.tag.kind = kind;
+  }
+}
+
+void
+hikari_latency_damage(struct hikari_latency *latency)
+{
+  if (input_state.depth == 0 || input_state.tag.input_nsec == 0) {
+    return;
+  }
+
+  // keep the earliest input whose effect has not been presented yet
+  if (latency->pending.input_nsec == 0) {
+    latency->pending = input_state.tag;
+    latency->pending_seq = input_state.seq;
+  }
+}
+
+void
+hikari_latency_commit(struct hikari_latency *latency)
+{
+  if (latency->pending.input_nsec != 0) {
+    latency->committed = true;
+  }
+}
@@ -554,7 +554,7 @@ destroy_popup_handler(struct wl_listener *listener, void *data)
 
   fini_popup(layer_popup);
 
-  hikari_free(layer_popup);
+  hikari_pool_free(HIKARI_POOL_LAYER_POPUP, layer_popup);
 }
 
 static void
@@ -602,7 +602,8 @@ new_popup_popup_handler(struct wl_listener *listener, void *data)
   struct wlr_xdg_popup *wlr_popup = data;
 
   struct hikari_layer_popup *layer_popup_popup =
-      hikari_malloc(sizeof(struct hikari_layer_popup));
+      hikari_pool_alloc(
+          HIKARI_POOL_LAYER_POPUP, sizeof(struct hikari_layer_popup));
 
   init_popup_popup(layer_popup_popup, layer_popup, wlr_popup);
 }
@@ -615,7 +616,8 @@ new_popup_handler(struct wl_listener *listener, void *data)
   hikari_log_trace("NEW LAYER POPUP");
 
   struct hikari_layer_popup *layer_popup =
-      hikari_malloc(sizeof(struct hikari_layer_popup));
+      hikari_pool_alloc(
+          HIKARI_POOL_LAYER_POPUP, sizeof(struct hikari_layer_popup));
 
   struct wlr_xdg_popup *wlr_popup = data;
 
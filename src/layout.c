@@ -122,5 +122,6 @@ hikari_layout_restack_prepend(struct hikari_layout *layout)
   restack(layout);
   raise_prependable(layout->sheet);
 
-  hikari_sheet_apply_split(layout->sheet, layout->split);
+  // prepended views go in front, containers are filled in stacking order
+  hikari_sheet_apply_split_in_order(layout->sheet, layout->split);
 }
@@ -4,9 +4,11 @@
 
 #include <wlr/backend.h>
 #include <wlr/render/wlr_renderer.h>
+#include <wlr/render/wlr_texture.h>
 
 #include <hikari/configuration.h>
 #include <hikari/geometry.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
 
@@ -47,6 +49,10 @@ init_indicator_circle(float color[static 4])
   texture = wlr_texture_from_pixels(
       wlr_renderer, DRM_FORMAT_ARGB8888, stride, size, size, data);
 
+  if (texture != NULL) {
+    hikari_memory_add_texture(HIKARI_MEMORY_INDICATORS, size, size);
+  }
+
   cairo_surface_destroy(surface);
   g_object_unref(layout);
   cairo_destroy(cairo);
@@ -54,6 +60,19 @@ init_indicator_circle(float color[static 4])
   return texture;
 }
 
+static void
+fini_indicator_circle(struct wlr_texture *texture)
+{
+  if (texture == NULL) {
+    return;
+  }
+
+  hikari_memory_remove_texture(
+      HIKARI_MEMORY_INDICATORS, texture->width, texture->height);
+
+  wlr_texture_destroy(texture);
+}
+
 static int
 reset_state_handler(void *data)
 {
@@ -92,10 +111,10 @@ hikari_lock_indicator_fini(struct hikari_lock_indicator *lock_indicator)
 {
   assert(lock_indicator != NULL);
 
-  wlr_texture_destroy(lock_indicator->wait);
-  wlr_texture_destroy(lock_indicator->type);
-  wlr_texture_destroy(lock_indicator->verify);
-  wlr_texture_destroy(lock_indicator->deny);
+  fini_indicator_circle(lock_indicator->wait);
+  fini_indicator_circle(lock_indicator->type);
+  fini_indicator_circle(lock_indicator->verify);
+  fini_indicator_circle(lock_indicator->deny);
 
   wl_event_source_remove(lock_indicator->reset_state);
 }
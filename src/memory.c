@@ -1,6 +1,11 @@
 #include <hikari/memory.h>
 
+#include <assert.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <hikari/log.h>
 
@@ -26,8 +31,439 @@ hikari_calloc(size_t number, size_t size)
   return ptr;
 }
 
+void *
+hikari_realloc(void *ptr, size_t size)
+{
+  void *new_ptr = realloc(ptr, size);
+  if (new_ptr == NULL) {
+    hikari_log_error("out of memory (realloc %zu bytes)", size);
+    abort();
+  }
+  return new_ptr;
+}
+
 void
 hikari_free(void *ptr)
 {
   free(ptr);
 }
+
+#define TAG_MAGIC 0x68696b61
+#define TEXTURE_BYTES_PER_PIXEL 4
+
+// configurations are parsed on a worker thread, counters have to be atomic
+struct memory_counter {
+  atomic_size_t bytes;
+  atomic_size_t peak;
+  atomic_size_t count;
+};
+
+struct memory_tag {
+  const char *name;
+
+  struct memory_counter heap;
+  struct memory_counter textures;
+};
+
+union tagged_header {
+  struct {
+    size_t size;
+    enum hikari_memory_tag tag;
+    uint32_t magic;
+  } info;
+  max_align_t alignment;
+};
+
+static struct memory_tag memory_tags[HIKARI_NR_OF_MEMORY_TAGS] = {
+  [HIKARI_MEMORY_VIEWS] = { .name = "views" },
+  [HIKARI_MEMORY_LAYOUTS] = { .name = "layouts" },
+  [HIKARI_MEMORY_CONFIGURATION] = { .name = "configuration" },
+  [HIKARI_MEMORY_INDICATORS] = { .name = "indicators" },
+  [HIKARI_MEMORY_BACKGROUNDS] = { .name = "backgrounds" },
+  [HIKARI_MEMORY_INPUT] = { .name = "input" },
+};
+
+static void
+counter_add(struct memory_counter *counter, size_t bytes)
+{
+  size_t live = atomic_fetch_add(&counter->bytes, bytes) + bytes;
+  atomic_fetch_add(&counter->count, 1);
+
+  size_t peak = atomic_load(&counter->peak);
+  while (live > peak &&
+         !atomic_compare_exchange_weak(&counter->peak, &peak, live)) {
+  }
+}
+
+static void
+counter_remove(struct memory_counter *counter, size_t bytes)
+{
+  atomic_fetch_sub(&counter->bytes, bytes);
+  atomic_fetch_sub(&counter->count, 1);
+}
+
+void *
+hikari_tagged_malloc(enum hikari_memory_tag tag, size_t size)
+{
+  assert(tag < HIKARI_NR_OF_MEMORY_TAGS);
+
+  union tagged_header *header =
+      hikari_malloc(sizeof(union tagged_header) + size);
+
+  header->info.size = size;
+  header->info.tag = tag;
+  header->info.magic = TAG_MAGIC;
+
+  counter_add(&memory_tags[tag].heap, size);
+
+  return header + 1;
+}
+
+void *
+hikari_tagged_calloc(enum hikari_memory_tag tag, size_t number, size_t size)
+{
+  if (size != 0 && number > (SIZE_MAX - sizeof(union tagged_header)) / size) {
+    hikari_log_error("out of memory (calloc %zu * %zu bytes)", number, size);
+    abort();
+  }
+
+  void *ptr = hikari_tagged_malloc(tag, number * size);
+  memset(ptr, 0, number * size);
+
+  return ptr;
+}
+
+void
+hikari_tagged_free(void *ptr)
+{
+  if (ptr == NULL) {
+    return;
+  }
+
+  union tagged_header *header = (union tagged_header *)ptr - 1;
+  assert(header->info.magic == TAG_MAGIC);
+
+  counter_remove(&memory_tags[header->info.tag].heap, header->info.size);
+
+  header->info.magic = 0;
+  hikari_free(header);
+}
+
+static size_t
+texture_size(int width, int height)
+{
+  if (width <= 0 || height <= 0) {
+    return 0;
+  }
+
+  return (size_t)width * height * TEXTURE_BYTES_PER_PIXEL;
+}
+
+void
+hikari_memory_add_texture(enum hikari_memory_tag tag, int width, int height)
+{
+  assert(tag < HIKARI_NR_OF_MEMORY_TAGS);
+
+  counter_add(&memory_tags[tag].textures, texture_size(width, height));
+}
+
+void
+hikari_memory_remove_texture(enum hikari_memory_tag tag, int width, int height)
+{
+  assert(tag < HIKARI_NR_OF_MEMORY_TAGS);
+
+  counter_remove(&memory_tags[tag].textures, texture_size(width, height));
+}
+
+#define OBJECTS_PER_SLAB 32
+#define POISON 0xdb
+
+#if defined(__SANITIZE_ADDRESS__)
+#include <sanitizer/asan_interface.h>
+#define POISON_OBJECT(ptr, size) ASAN_POISON_MEMORY_REGION(ptr, size)
+#define UNPOISON_OBJECT(ptr, size) ASAN_UNPOISON_MEMORY_REGION(ptr, size)
+#else
+#define POISON_OBJECT(ptr, size) ((void)(ptr), (void)(size))
+#define UNPOISON_OBJECT(ptr, size) ((void)(ptr), (void)(size))
+#endif
+
+struct pool_object {
+  struct pool_object *next;
+};
+
+struct pool_slab {
+  struct pool_slab *next;
+};
+
+struct pool {
+  const char *name;
+  enum hikari_memory_tag tag;
+  size_t size;
+  size_t object_size;
+
+  struct pool_slab *slabs;
+  struct pool_object *free_objects;
+
+  size_t live;
+  size_t peak;
+  size_t freed;
+  size_t nr_of_slabs;
+};
+
+static struct pool pools[HIKARI_NR_OF_POOLS] = {
+  [HIKARI_POOL_XDG_VIEW] = {
+    .name = "xdg_view",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_XWAYLAND_VIEW] = {
+    .name = "xwayland_view",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_XWAYLAND_UNMANAGED_VIEW] = {
+    .name = "unmanaged_view",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_VIEW_SUBSURFACE] = {
+    .name = "view_subsurface",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_XDG_POPUP] = {
+    .name = "xdg_popup",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_LAYER_POPUP] = {
+    .name = "layer_popup",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_INPUT_POPUP] = {
+    .name = "input_popup",
+    .tag = HIKARI_MEMORY_INPUT,
+  },
+  [HIKARI_POOL_TILE] = {
+    .name = "tile",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+  [HIKARI_POOL_MAXIMIZED_STATE] = {
+    .name = "maximized_state",
+    .tag = HIKARI_MEMORY_VIEWS,
+  },
+};
+
+static size_t
+align_size(size_t size)
+{
+  size_t alignment = _Alignof(max_align_t);
+  return (size + alignment - 1) & ~(alignment - 1);
+}
+
+#ifndef NDEBUG
+static void
+poison_object(struct pool *pool, struct pool_object *object)
+{
+  memset((char *)object + sizeof(struct pool_object),
+      POISON,
+      pool->object_size - sizeof(struct pool_object));
+}
+
+static void
+check_poison(struct pool *pool, struct pool_object *object)
+{
+  unsigned char *bytes = (unsigned char *)object;
+
+  for (size_t i = sizeof(struct pool_object); i < pool->object_size; i++) {
+    if (bytes[i] != POISON) {
+      hikari_log_error("%s %p was written to after it was freed (offset %zu)",
+          pool->name,
+          (void *)object,
+          i);
+      abort();
+    }
+  }
+}
+#endif
+
+static void
+release_object(struct pool *pool, struct pool_object *object)
+{
+  object->next = pool->free_objects;
+  pool->free_objects = object;
+
+#ifndef NDEBUG
+  poison_object(pool, object);
+#endif
+
+  POISON_OBJECT(object, pool->object_size);
+}
+
+static void
+grow_pool(struct pool *pool)
+{
+  size_t header_size = align_size(sizeof(struct pool_slab));
+  struct pool_slab *slab =
+      hikari_malloc(header_size + OBJECTS_PER_SLAB * pool->object_size);
+
+  slab->next = pool->slabs;
+  pool->slabs = slab;
+  pool->nr_of_slabs++;
+
+  char *objects = (char *)slab + header_size;
+  for (int i = OBJECTS_PER_SLAB - 1; i >= 0; i--) {
+    struct pool_object *object =
+        (struct pool_object *)(objects + i * pool->object_size);
+    release_object(pool, object);
+  }
+}
+
+void *
+hikari_pool_alloc(enum hikari_pool_type type, size_t size)
+{
+  assert(type < HIKARI_NR_OF_POOLS);
+  struct pool *pool = &pools[type];
+
+  if (pool->size == 0) {
+    pool->size = size;
+    pool->object_size = align_size(
+        size > sizeof(struct pool_object) ? size : sizeof(struct pool_object));
+  }
+
+  assert(pool->size == size);
+
+  if (pool->free_objects == NULL) {
+    grow_pool(pool);
+  }
+
+  struct pool_object *object = pool->free_objects;
+  UNPOISON_OBJECT(object, pool->object_size);
+  pool->free_objects = object->next;
+
+#ifndef NDEBUG
+  check_poison(pool, object);
+#endif
+
+  pool->live++;
+  if (pool->live > pool->peak) {
+    pool->peak = pool->live;
+  }
+
+  counter_add(&memory_tags[pool->tag].heap, pool->object_size);
+
+  return object;
+}
+
+void
+hikari_pool_free(enum hikari_pool_type type, void *ptr)
+{
+  if (ptr == NULL) {
+    return;
+  }
+
+  assert(type < HIKARI_NR_OF_POOLS);
+  struct pool *pool = &pools[type];
+
+  assert(pool->live > 0);
+
+  pool->live--;
+  pool->freed++;
+
+  counter_remove(&memory_tags[pool->tag].heap, pool->object_size);
+
+  release_object(pool, ptr);
+}
+
+void
+hikari_pool_stats(enum hikari_pool_type type, struct hikari_pool_stats *stats)
+{
+  assert(type < HIKARI_NR_OF_POOLS);
+  struct pool *pool = &pools[type];
+
+  stats->name = pool->name;
+  stats->object_size = pool->object_size;
+  stats->live = pool->live;
+  stats->peak = pool->peak;
+  stats->freed = pool->freed;
+  stats->nr_of_slabs = pool->nr_of_slabs;
+}
+
+void
+hikari_memory_dump(void)
+{
+  hikari_log_info("%-14s %12s %12s %8s %12s %12s %8s",
+      "subsystem",
+      "heap",
+      "heap peak",
+      "allocs",
+      "textures",
+      "texture peak",
+      "count");
+
+  for (int i = 0; i < HIKARI_NR_OF_MEMORY_TAGS; i++) {
+    struct memory_tag *memory_tag = &memory_tags[i];
+
+    hikari_log_info("%-14s %12zu %12zu %8zu %12zu %12zu %8zu",
+        memory_tag->name,
+        atomic_load(&memory_tag->heap.bytes),
+        atomic_load(&memory_tag->heap.peak),
+        atomic_load(&memory_tag->heap.count),
+        atomic_load(&memory_tag->textures.bytes),
+        atomic_load(&memory_tag->textures.peak),
+        atomic_load(&memory_tag->textures.count));
+  }
+
+  for (int i = 0; i < HIKARI_NR_OF_POOLS; i++) {
+    struct pool *pool = &pools[i];
+
+    if (pool->nr_of_slabs == 0) {
+      continue;
+    }
+
+    hikari_log_info("pool %-22s %5zu bytes %6zu live %6zu peak %8zu freed "
+                    "%4zu slabs",
+        pool->name,
+        pool->object_size,
+        pool->live,
+        pool->peak,
+        pool->freed,
+        pool->nr_of_slabs);
+  }
+}
+
+void
+hikari_pools_fini(void)
+{
+  for (int i = 0; i < HIKARI_NR_OF_POOLS; i++) {
+    struct pool *pool = &pools[i];
+
+    if (pool->nr_of_slabs == 0) {
+      continue;
+    }
+
+    hikari_log_debug("pool %s: %zu bytes, %zu live, %zu peak, %zu freed, "
+                     "%zu slabs",
+        pool->name,
+        pool->object_size,
+        pool->live,
+        pool->peak,
+        pool->freed,
+        pool->nr_of_slabs);
+
+    if (pool->live > 0) {
+      hikari_log_warn("pool %s: %zu objects still live", pool->name, pool->live);
+    }
+
+    size_t slab_size = align_size(sizeof(struct pool_slab)) +
+                       OBJECTS_PER_SLAB * pool->object_size;
+
+    struct pool_slab *slab = pool->slabs;
+    while (slab != NULL) {
+      struct pool_slab *next = slab->next;
+      UNPOISON_OBJECT(slab, slab_size);
+      hikari_free(slab);
+      slab = next;
+    }
+
+    pool->slabs = NULL;
+    pool->free_objects = NULL;
+    pool->live = 0;
+    pool->nr_of_slabs = 0;
+  }
+}
@@ -12,6 +12,7 @@
 #include <hikari/indicator_frame.h>
 #include <hikari/log.h>
 #include <hikari/keyboard.h>
+#include <hikari/keymap.h>
 #include <hikari/renderer.h>
 #include <hikari/server.h>
 #include <hikari/view.h>
@@ -147,6 +148,7 @@ modifiers_handler(struct hikari_keyboard *keyboard)
   if (hikari_server.keyboard_state.mod_released) {
 
     if (hikari_server_is_cycling() && focus_view != NULL) {
+      hikari_workspace_commit_focus(hikari_server.workspace);
       hikari_view_raise(focus_view);
       hikari_view_center_cursor(focus_view);
       hikari_server_cursor_focus();
@@ -318,9 +320,10 @@ key_handler(
     return;
   }
 
-  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED) {
+  if (event->state == WL_KEYBOARD_KEY_STATE_PRESSED &&
+      keyboard->keymap != NULL) {
     uint32_t modifiers = hikari_server.keyboard_state.modifiers;
-    struct hikari_binding_group *bindings = &keyboard->bindings[modifiers];
+    struct hikari_binding_group *bindings = &keyboard->keymap->bindings[modifiers];
 
     if (handle_input(bindings, event->keycode)) {
       hikari_log_debug("consumed: keycode=%u modifiers=0x%x", event->keycode, modifiers);
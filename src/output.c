@@ -50,15 +50,27 @@ render_image_to_surface(cairo_surface_t *output,
   cairo_destroy(cairo);
 }
 
+static void
+destroy_background(struct hikari_output *output)
+{
+  if (output->background == NULL) {
+    return;
+  }
+
+  hikari_memory_remove_texture(HIKARI_MEMORY_BACKGROUNDS,
+      output->background->width,
+      output->background->height);
+
+  wlr_texture_destroy(output->background);
+  output->background = NULL;
+}
+
 void
 hikari_output_load_background(struct hikari_output *output,
     const char *path,
     enum hikari_background_fit background_fit)
 {
-  if (output->background != NULL) {
-    wlr_texture_destroy(output->background);
-    output->background = NULL;
-  }
+  destroy_background(output);
 
   assert(output->background == NULL);
 
@@ -91,6 +103,11 @@ hikari_output_load_background(struct hikari_output *output,
   output->background = wlr_texture_from_pixels(
       renderer, DRM_FORMAT_ARGB8888, stride, output_width, output_height, data);
 
+  if (output->background != NULL) {
+    hikari_memory_add_texture(
+        HIKARI_MEMORY_BACKGROUNDS, output_width, output_height);
+  }
+
   cairo_surface_destroy(image);
   cairo_surface_destroy(output_surface);
 
@@ -106,6 +123,7 @@ hikari_output_damage_whole(struct hikari_output *output)
   assert(output != NULL);
 
   wlr_damage_ring_add_whole(&output->damage);
+  hikari_latency_damage(&output->latency);
   wlr_output_schedule_frame(output->wlr_output);
 }
 
@@ -225,8 +243,11 @@ hikari_output_init(struct hikari_output *output, struct wlr_output *wlr_output)
   output->swapchain = NULL;
   output->background = NULL;
   output->enabled = false;
+  output->damage_suspended = false;
   output->workspace = hikari_malloc(sizeof(struct hikari_workspace));
 
+  hikari_latency_init(&output->latency, wlr_output);
+
 #ifdef HAVE_XWAYLAND
   wl_list_init(&output->unmanaged_xwayland_views);
 #endif
@@ -308,6 +329,8 @@ hikari_output_fini(struct hikari_output *output)
 
   hikari_output_disable(output);
 
+  hikari_latency_fini(&output->latency);
+
   wl_list_remove(&output->destroy.link);
 
   struct hikari_workspace *workspace = output->workspace;
@@ -316,7 +339,7 @@ hikari_output_fini(struct hikari_output *output)
     struct hikari_workspace *merge_workspace;
     struct hikari_workspace *next_workspace = hikari_workspace_next(workspace);
 
-    wlr_texture_destroy(output->background);
+    destroy_background(output);
 
     if (workspace != next_workspace) {
       merge_workspace = next_workspace;
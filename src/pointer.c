@@ -13,7 +13,7 @@ destroy_handler(struct wl_listener *listener, void *data)
   struct hikari_pointer *pointer = wl_container_of(listener, pointer, destroy);
 
   hikari_pointer_fini(pointer);
-  hikari_free(pointer);
+  hikari_tagged_free(pointer);
 }
 
 void
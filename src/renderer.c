@@ -9,6 +9,7 @@
 #include <hikari/log.h>
 #include <hikari/output.h>
 #include <hikari/renderer.h>
+#include <hikari/startup.h>
 #include <hikari/view.h>
 
 #ifdef HAVE_XWAYLAND
@@ -521,7 +522,13 @@ hikari_renderer_damage_frame_handler(struct wl_listener *listener, void *data)
   wlr_output_state_init(&state);
   wlr_output_state_set_buffer(&state, buffer);
   wlr_output_state_set_damage(&state, &damage);
-  wlr_output_commit_state(wlr_output, &state);
+  if (wlr_output_commit_state(wlr_output, &state)) {
+    hikari_latency_commit(&output->latency);
+
+    if (output != hikari_server.noop_output) {
+      hikari_startup_first_frame();
+    }
+  }
   wlr_output_state_finish(&state);
 
   pixman_region32_fini(&damage);
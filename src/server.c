@@ -2,6 +2,7 @@
 
 #include <errno.h>
 #include <libinput.h>
+#include <signal.h>
 #include <unistd.h>
 
 #include <wlr/backend.h>
@@ -51,9 +52,12 @@
 #include <hikari/border.h>
 #include <hikari/command.h>
 #include <hikari/configuration.h>
+#include <hikari/configuration_reload.h>
 #include <hikari/decoration.h>
 #include <hikari/exec.h>
+#include <hikari/input_log.h>
 #include <hikari/keyboard.h>
+#include <hikari/keymap_cache.h>
 #include <hikari/layout.h>
 #include <hikari/mark.h>
 #include <hikari/memory.h>
@@ -61,6 +65,7 @@
 #include <hikari/pointer.h>
 #include <hikari/pointer_config.h>
 #include <hikari/sheet.h>
+#include <hikari/startup.h>
 #include <hikari/switch.h>
 #include <hikari/workspace.h>
 #include <hikari/xdg_view.h>
@@ -75,7 +80,8 @@ add_pointer(struct hikari_server *server, struct wlr_input_device *device)
 {
   hikari_log_debug("add_pointer: name='%s'", device->name);
 
-  struct hikari_pointer *pointer = hikari_malloc(sizeof(struct hikari_pointer));
+  struct hikari_pointer *pointer =
+      hikari_tagged_malloc(HIKARI_MEMORY_INPUT, sizeof(struct hikari_pointer));
   hikari_pointer_init(pointer, device);
 
   struct hikari_pointer_config *pointer_config =
@@ -99,7 +105,7 @@ add_keyboard(struct hikari_server *server, struct wlr_input_device *device)
 {
   (void)server;
   struct hikari_keyboard *keyboard =
-      hikari_malloc(sizeof(struct hikari_keyboard));
+      hikari_tagged_malloc(HIKARI_MEMORY_INPUT, sizeof(struct hikari_keyboard));
 
   hikari_keyboard_init(keyboard, device);
 
@@ -108,17 +114,17 @@ add_keyboard(struct hikari_server *server, struct wlr_input_device *device)
           hikari_configuration, device->name);
 
   assert(keyboard_config != NULL);
-  hikari_keyboard_configure(keyboard, keyboard_config);
-
-  hikari_keyboard_configure_bindings(
-      keyboard, &hikari_configuration->keyboard_binding_configs);
+  hikari_keyboard_configure(keyboard,
+      keyboard_config,
+      &hikari_configuration->keyboard_binding_configs);
 }
 
 static void
 add_switch(struct hikari_server *server, struct wlr_input_device *device)
 {
   (void)server;
-  struct hikari_switch *swtch = hikari_malloc(sizeof(struct hikari_switch));
+  struct hikari_switch *swtch =
+      hikari_tagged_malloc(HIKARI_MEMORY_INPUT, sizeof(struct hikari_switch));
 
   hikari_switch_init(swtch, device);
 
@@ -501,13 +507,15 @@ new_xwayland_surface_handler(struct wl_listener *listener, void *data)
 
   if (wlr_xwayland_surface->override_redirect) {
     struct hikari_xwayland_unmanaged_view *xwayland_unmanaged_view =
-        hikari_malloc(sizeof(struct hikari_xwayland_unmanaged_view));
+        hikari_pool_alloc(HIKARI_POOL_XWAYLAND_UNMANAGED_VIEW,
+            sizeof(struct hikari_xwayland_unmanaged_view));
 
     hikari_xwayland_unmanaged_view_init(
         xwayland_unmanaged_view, wlr_xwayland_surface, workspace);
   } else {
     struct hikari_xwayland_view *xwayland_view =
-        hikari_malloc(sizeof(struct hikari_xwayland_view));
+        hikari_pool_alloc(
+            HIKARI_POOL_XWAYLAND_VIEW, sizeof(struct hikari_xwayland_view));
 
     hikari_xwayland_view_init(xwayland_view, wlr_xwayland_surface, workspace);
   }
@@ -516,8 +524,31 @@ new_xwayland_surface_handler(struct wl_listener *listener, void *data)
 static void
 setup_xwayland(struct hikari_server *server)
 {
-  server->xwayland =
-      wlr_xwayland_create(server->display, server->compositor, true);
+  bool lazy = hikari_configuration->xwayland_lazy;
+
+  // a lazy server listens on the X11 socket and only spawns Xwayland for the
+  // first client, after the idle timeout it exits and starts listening again
+  struct wlr_xwayland_server_options options = {
+    .lazy = lazy,
+    .enable_wm = true,
+    .terminate_delay = lazy ? hikari_configuration->xwayland_idle_timeout : 0,
+  };
+
+  server->xwayland_server =
+      wlr_xwayland_server_create(server->display, &options);
+  if (server->xwayland_server == NULL) {
+    hikari_log_error("could not create Xwayland server");
+    wl_display_destroy(server->display);
+    exit(EXIT_FAILURE);
+  }
+
+  server->xwayland = wlr_xwayland_create_with_server(
+      server->display, server->compositor, server->xwayland_server);
+  if (server->xwayland == NULL) {
+    hikari_log_error("could not create Xwayland");
+    wl_display_destroy(server->display);
+    exit(EXIT_FAILURE);
+  }
 
   server->new_xwayland_surface.notify = new_xwayland_surface_handler;
   wl_signal_add(
@@ -558,8 +589,6 @@ server_decoration_handler(struct wl_listener *listener, void *data)
 {
   (void)listener;
   struct wlr_server_decoration *wlr_decoration = data;
-  struct hikari_view *view =
-      wl_container_of(wlr_decoration->surface, view, surface);
   struct wlr_xdg_surface *xdg_surface =
       wlr_xdg_surface_try_from_wlr_surface(wlr_decoration->surface);
   struct hikari_xdg_view *xdg_view = xdg_surface->data;
@@ -680,7 +709,7 @@ new_xdg_toplevel_handler(struct wl_listener *listener, void *data)
   struct wlr_xdg_surface *xdg_surface = xdg_toplevel->base;
 
   struct hikari_xdg_view *xdg_view =
-      hikari_malloc(sizeof(struct hikari_xdg_view));
+      hikari_pool_alloc(HIKARI_POOL_XDG_VIEW, sizeof(struct hikari_xdg_view));
 
   hikari_xdg_view_init(xdg_view, xdg_surface, server->workspace);
 }
@@ -868,6 +897,8 @@ hikari_server_prepare_privileged(void)
   bool success = false;
   struct hikari_server *server = &hikari_server;
 
+  hikari_startup_begin();
+
   server->display = wl_display_create();
   if (server->display == NULL) {
     hikari_log_error("could not create display");
@@ -880,12 +911,16 @@ hikari_server_prepare_privileged(void)
     goto done;
   }
 
+  hikari_startup_phase("display");
+
   server->backend = wlr_backend_autocreate(server->event_loop, &server->session);
   if (server->backend == NULL) {
     hikari_log_error("could not create backend");
     goto done;
   }
 
+  hikari_startup_phase("backend");
+
   success = true;
 
 done:
@@ -922,6 +957,17 @@ init_noop_output(struct hikari_server *server)
   hikari_server.mode = (struct hikari_mode *)&hikari_server.normal_mode;
 }
 
+static int
+memory_dump_handler(int signal, void *data)
+{
+  (void)signal;
+  (void)data;
+
+  hikari_memory_dump();
+
+  return 0;
+}
+
 static void
 server_init(struct hikari_server *server, char *config_path)
 {
@@ -931,11 +977,27 @@ server_init(struct hikari_server *server, char *config_path)
   server->shutdown_timer = NULL;
   server->config_path = config_path;
 
+  // signal sources block their signal in the calling thread, they have to be
+  // added before any worker thread is started so the workers inherit the mask
+  server->memory_dump = wl_event_loop_add_signal(
+      server->event_loop, SIGUSR1, memory_dump_handler, NULL);
+
+  hikari_keymap_cache_init();
+
+  if (!hikari_command_init(server->event_loop) ||
+      !hikari_configuration_reload_init(server->event_loop)) {
+    wl_display_destroy(server->display);
+    exit(EXIT_FAILURE);
+  }
+
+  hikari_startup_phase("workers");
+
   hikari_configuration = hikari_malloc(sizeof(struct hikari_configuration));
 
   hikari_configuration_init(hikari_configuration);
 
-  if (!hikari_configuration_load(hikari_configuration, config_path)) {
+  if (!hikari_configuration_load(hikari_configuration, config_path) ||
+      !hikari_configuration_compile_keymaps(hikari_configuration)) {
     hikari_configuration_fini(hikari_configuration);
     hikari_free(hikari_configuration);
 
@@ -943,12 +1005,15 @@ server_init(struct hikari_server *server, char *config_path)
     exit(EXIT_FAILURE);
   }
 
+  hikari_startup_phase("config");
+
   server->keyboard_state.modifiers = 0;
   server->keyboard_state.mod_released = false;
   server->keyboard_state.mod_changed = false;
   server->keyboard_state.mod_pressed = false;
 
   server->cycling = false;
+  server->focus_deferred = false;
   server->workspace = NULL;
 
   hikari_indicator_init(
@@ -973,6 +1038,8 @@ server_init(struct hikari_server *server, char *config_path)
     exit(EXIT_FAILURE);
   }
 
+  hikari_startup_phase("renderer");
+
   server->socket = wl_display_add_socket_auto(server->display);
   if (server->socket == NULL) {
     wl_display_destroy(server->display);
@@ -1018,10 +1085,14 @@ server_init(struct hikari_server *server, char *config_path)
   wlr_screencopy_manager_v1_create(server->display);
 #endif
 
+  hikari_startup_phase("globals");
+
 #ifdef HAVE_XWAYLAND
   setup_xwayland(server);
+  hikari_startup_phase("xwayland");
 #endif
   setup_cursor(server);
+  hikari_startup_phase("cursor");
 #ifdef HAVE_VIRTUAL_INPUT
   setup_virtual_keyboard(server);
   setup_virtual_pointer(server);
@@ -1039,12 +1110,17 @@ server_init(struct hikari_server *server, char *config_path)
   wlr_xdg_toplevel_icon_manager_v1_create(server->display, 1);
   setup_input_method(server);
 
+  hikari_startup_phase("protocols");
+
   wl_list_init(&server->pointers);
   wl_list_init(&server->keyboards);
+  wl_list_init(&server->keymaps);
   wl_list_init(&server->switches);
 
   wl_list_init(&server->groups);
   wl_list_init(&server->visible_groups);
+  hikari_hash_map_init(&server->groups_by_name);
+  hikari_completion_index_init(&server->group_names);
   wl_list_init(&server->visible_views);
 
   hikari_dnd_mode_init(&server->dnd_mode);
@@ -1062,6 +1138,8 @@ server_init(struct hikari_server *server, char *config_path)
   hikari_marks_init();
 
   init_noop_output(server);
+
+  hikari_startup_phase("modes");
 }
 
 static void
@@ -1085,8 +1163,12 @@ hikari_server_start(char *config_path, char *autostart)
   signal(SIGTERM, sig_handler);
 
   wlr_backend_start(hikari_server.backend);
+  hikari_input_log_start();
+
+  hikari_startup_phase("backend-start");
 
   if (autostart != NULL) {
+    hikari_startup_autostart();
     run_autostart(autostart);
   }
 
@@ -1158,6 +1240,8 @@ hikari_server_stop(void)
 {
   struct hikari_server *server = &hikari_server;
 
+  hikari_input_log_fini();
+
   wl_list_remove(&server->new_output.link);
   wl_list_remove(&server->new_input.link);
   wl_list_remove(&server->new_xdg_toplevel.link);
@@ -1185,6 +1269,10 @@ hikari_server_stop(void)
     destroy_shutdown_timer(server);
   }
 
+  if (server->memory_dump != NULL) {
+    wl_event_source_remove(server->memory_dump);
+  }
+
   hikari_cursor_fini(&server->cursor);
   hikari_indicator_fini(&server->indicator);
 
@@ -1201,25 +1289,30 @@ hikari_server_stop(void)
   wl_list_for_each_safe(keyboard, keyboard_tmp, &server->keyboards,
       server_keyboards) {
     hikari_keyboard_fini(keyboard);
-    hikari_free(keyboard);
+    hikari_tagged_free(keyboard);
   }
 
   struct hikari_switch *swtch, *swtch_tmp;
   wl_list_for_each_safe(swtch, swtch_tmp, &server->switches,
       server_switches) {
     hikari_switch_fini(swtch);
-    hikari_free(swtch);
+    hikari_tagged_free(swtch);
   }
 
   struct hikari_pointer *pointer, *pointer_tmp;
   wl_list_for_each_safe(pointer, pointer_tmp, &server->pointers,
       server_pointers) {
     hikari_pointer_fini(pointer);
-    hikari_free(pointer);
+    hikari_tagged_free(pointer);
   }
 
+  hikari_configuration_reload_fini();
+  hikari_keymap_cache_fini();
+  hikari_command_fini();
+
 #if HAVE_XWAYLAND
   wlr_xwayland_destroy(server->xwayland);
+  wlr_xwayland_server_destroy(server->xwayland_server);
 #endif
 
   wl_list_remove(&server->input_method_relay.new_text_input.link);
@@ -1234,20 +1327,26 @@ hikari_server_stop(void)
   hikari_free(hikari_configuration);
   hikari_marks_fini();
 
+  hikari_hash_map_fini(&server->groups_by_name);
+  hikari_completion_index_fini(&server->group_names);
+  hikari_pools_fini();
+
   free(server->config_path);
 }
 
 struct hikari_group *
 hikari_server_find_group(const char *group_name)
 {
-  struct hikari_group *group;
-  wl_list_for_each (group, &hikari_server.groups, server_groups) {
-    if (!strcmp(group_name, group->name)) {
-      return group;
-    }
+  struct hikari_hash_map_entry *entry =
+      hikari_hash_map_lookup(&hikari_server.groups_by_name, group_name);
+
+  if (entry == NULL) {
+    return NULL;
   }
 
-  return NULL;
+  struct hikari_group *group = wl_container_of(entry, group, name_entry);
+
+  return group;
 }
 
 struct hikari_group *
@@ -1277,6 +1376,13 @@ hikari_server_reload(void *arg)
   hikari_configuration_reload(hikari_server.config_path);
 }
 
+void
+hikari_server_dump_memory(void *arg)
+{
+  (void)arg;
+  hikari_memory_dump();
+}
+
 #define CYCLE_VIEW(name, link)                                                 \
   static struct hikari_view *cycle_##name##_view(void)                         \
   {                                                                            \
@@ -1392,6 +1498,7 @@ hikari_server_enter_normal_mode(void *arg)
   hikari_cursor_reset_image(&server->cursor);
 
   hikari_normal_mode_enter();
+  hikari_workspace_commit_focus(server->workspace);
 
   hikari_server_cursor_focus();
 }
@@ -1468,6 +1575,7 @@ hikari_server_enter_input_grab_mode(void *arg)
     return;
   }
 
+  hikari_workspace_commit_focus(workspace);
   update_indication(focus_view);
 
   hikari_input_grab_mode_enter(focus_view);
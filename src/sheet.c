@@ -2,12 +2,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <hikari/configuration.h>
 #include <hikari/group.h>
 #include <hikari/layout.h>
 #include <hikari/memory.h>
 #include <hikari/split.h>
+#include <hikari/tile.h>
+#include <hikari/transaction.h>
 #include <hikari/view.h>
 
 void
@@ -17,275 +20,34 @@ hikari_sheet_init(
   assert(workspace->output != NULL);
 
   wl_list_init(&sheet->views);
+  wl_list_init(&sheet->tileable_views);
 
   sheet->nr = nr;
+  sheet->nr_of_tileable_views = 0;
+  sheet->nr_of_dirty_tileable_views = 0;
 
   sheet->workspace = workspace;
   sheet->layout = NULL;
 }
 
-static struct hikari_view *
-scan_next_tileable_view(struct hikari_view *view)
-{
-  assert(view != NULL);
-
-  struct wl_list *next = view->sheet_views.next;
-
-  while (next != &view->sheet->views) {
-    view = wl_container_of(next, view, sheet_views);
-    if (hikari_view_is_tileable(view)) {
-      assert(!hikari_view_is_hidden(view));
-      return view;
-    }
-    next = view->sheet_views.next;
-  }
-
-  return NULL;
-}
-
 struct hikari_view *
 hikari_sheet_first_tileable_view(struct hikari_sheet *sheet)
 {
   assert(sheet != NULL);
 
-  struct wl_list *next = sheet->views.next;
-  struct hikari_view *view = NULL;
-
-  while (next != &sheet->views) {
-    view = wl_container_of(next, view, sheet_views);
+  struct hikari_view *view;
+  wl_list_for_each (view, &sheet->tileable_views, tileable_sheet_views) {
     if (hikari_view_is_tileable(view)) {
       if (hikari_view_is_hidden(view)) {
         hikari_view_show(view);
       }
       return view;
     }
-    next = view->sheet_views.next;
   }
 
   return NULL;
 }
 
-static int
-tileable_views(struct hikari_view *view)
-{
-  int result;
-  if (hikari_view_is_tileable(view)) {
-    result = 1;
-  } else {
-    result = 0;
-  }
-
-  struct wl_list *next = view->sheet_views.next;
-
-  while (next != &view->sheet->views) {
-    view = wl_container_of(next, view, sheet_views);
-    if (hikari_view_is_tileable(view)) {
-      result++;
-    }
-    next = view->sheet_views.next;
-  }
-
-  return result;
-}
-
-static struct hikari_view *
-single_layout(struct wlr_box *frame,
-    struct hikari_view *first,
-    int nr_of_views,
-    bool *center)
-{
-  (void)nr_of_views;
-  hikari_view_tile(first, frame, *center);
-  *center = false;
-  return scan_next_tileable_view(first);
-}
-
-static struct hikari_view *
-empty_layout(struct wlr_box *frame,
-    struct hikari_view *first,
-    int nr_of_views,
-    bool *center)
-{
-  (void)frame;
-  (void)nr_of_views;
-  (void)center;
-  return first;
-}
-
-static struct hikari_view *
-full_layout(struct wlr_box *frame,
-    struct hikari_view *first,
-    int nr_of_views,
-    bool *center)
-{
-  struct hikari_view *view = first;
-  for (int i = 0; i < nr_of_views && view != NULL; i++) {
-    if (hikari_view_is_tileable(view)) {
-      if (hikari_view_is_hidden(view)) {
-        hikari_view_show(view);
-      }
-      hikari_view_tile(view, frame, *center);
-      *center = false;
-    }
-    view = scan_next_tileable_view(view);
-  }
-
-  return view;
-}
-
-#define LAYOUT_VIEWS(nr_of_views, view, frame, center)                         \
-  if (nr_of_views == 0) {                                                      \
-    return NULL;                                                               \
-  } else if (nr_of_views == 1) {                                               \
-    hikari_view_tile(view, frame, *center);                                    \
-    *center = false;                                                           \
-  } else
-
-static struct hikari_view *
-grid_layout(struct wlr_box *frame,
-    struct hikari_view *first,
-    int nr_of_views,
-    bool *center)
-{
-  int nr_of_rows = 1;
-  int nr_of_cols = 1;
-
-  for (int i = 1; i <= nr_of_views; i++) {
-    if (i > nr_of_rows * nr_of_cols) {
-      if (nr_of_cols > nr_of_rows) {
-        assert(nr_of_cols == nr_of_rows + 1);
-        nr_of_rows++;
-      } else {
-        nr_of_cols++;
-      }
-    }
-  }
-
-  struct hikari_view *view = first;
-  LAYOUT_VIEWS(nr_of_views, first, frame, center)
-  {
-    int border_width = hikari_configuration->border;
-    int gap = hikari_configuration->gap;
-    int border = 2 * border_width;
-    int row_gaps = nr_of_rows - 1;
-    int col_gaps = nr_of_cols - 1;
-    int gaps_height = gap * row_gaps;
-    int gaps_width = gap * col_gaps;
-    int views_height = frame->height - border * nr_of_rows - gaps_height;
-    int views_width = frame->width - border * nr_of_cols - gaps_width;
-
-    int width = views_width / nr_of_cols;
-    int height = views_height / nr_of_rows;
-
-    int rest_width =
-        frame->width - border * col_gaps - gaps_width - width * nr_of_cols;
-
-    int rest_height =
-        frame->height - border * row_gaps - gaps_height - height * nr_of_rows;
-
-    struct wlr_box geometry = { .y = frame->y, .x = frame->x };
-
-    geometry.height = height + rest_height;
-    for (int g_y = 0; g_y < nr_of_rows; g_y++) {
-      if (g_y == 1) {
-        geometry.height = height;
-      }
-      geometry.width = width + rest_width;
-      for (int g_x = 0; g_x < nr_of_cols; g_x++) {
-        if (g_x == 1) {
-          geometry.width = width;
-        }
-        hikari_view_tile(view, &geometry, *center);
-        *center = false;
-
-        view = scan_next_tileable_view(view);
-        if (view == NULL) {
-          return NULL;
-        }
-
-        geometry.x += gap + border + geometry.width;
-      }
-      geometry.x = frame->x;
-      geometry.y += gap + border + geometry.height;
-    }
-  }
-
-  return scan_next_tileable_view(view);
-}
-
-#define SPLIT_LAYOUT(name, x, y, width, height)                                \
-  static struct hikari_view *name##_layout(struct wlr_box *frame,              \
-      struct hikari_view *first,                                               \
-      int nr_of_views,                                                         \
-      bool *center)                                                            \
-  {                                                                            \
-    struct hikari_view *view = first;                                          \
-    int border_width = hikari_configuration->border;                           \
-    int gap = hikari_configuration->gap;                                       \
-    int border = 2 * border_width;                                             \
-    int gaps = nr_of_views - 1;                                                \
-    int gaps_##width = gap * gaps;                                             \
-                                                                               \
-    LAYOUT_VIEWS(nr_of_views, first, frame, center)                            \
-    {                                                                          \
-      int views_width = frame->width - border * gaps - gaps_##width;           \
-      int width = views_width / nr_of_views;                                   \
-      int rest = views_width - width * nr_of_views;                            \
-                                                                               \
-      struct wlr_box geometry = { .x = frame->x,                               \
-        .y = frame->y,                                                         \
-        .width = width + rest,                                                 \
-        .height = frame->height };                                             \
-                                                                               \
-      hikari_view_tile(first, &geometry, *center);                             \
-      *center = false;                                                         \
-                                                                               \
-      geometry.x += gap + border + width + rest;                               \
-      geometry.width = width;                                                  \
-      for (int n = 1; n < nr_of_views; n++) {                                  \
-        view = scan_next_tileable_view(view);                                  \
-        hikari_view_tile(view, &geometry, *center);                            \
-        *center = false;                                                       \
-        geometry.x += gap + border + width;                                    \
-      }                                                                        \
-    }                                                                          \
-                                                                               \
-    return scan_next_tileable_view(view);                                      \
-  }
-
-SPLIT_LAYOUT(queue, x, y, width, height)
-SPLIT_LAYOUT(stack, y, x, height, width)
-#undef SPLIT_LAYOUT
-
-#define LAYOUT(name)                                                           \
-  struct hikari_view *hikari_sheet_##name##_layout(struct hikari_sheet *sheet, \
-      struct hikari_view *first,                                               \
-      struct wlr_box *frame,                                                   \
-      int max,                                                                 \
-      bool *center)                                                            \
-  {                                                                            \
-    (void)sheet;                                                               \
-    int nr_of_views = tileable_views(first);                                   \
-    if (nr_of_views > max) {                                                   \
-      nr_of_views = max;                                                       \
-    }                                                                          \
-    if (nr_of_views == 0 && max != 0) {                                        \
-      return NULL;                                                             \
-    }                                                                          \
-                                                                               \
-    return name##_layout(frame, first, nr_of_views, center);                   \
-  }
-
-LAYOUT(queue)
-LAYOUT(stack)
-LAYOUT(grid)
-LAYOUT(full)
-LAYOUT(single)
-LAYOUT(empty)
-#undef LAYOUT
-
-#undef LAYOUT_WINDOWS
-
 #define SHEET_VIEW(name, link)                                                 \
   struct hikari_view *hikari_sheet_##name##_view(struct hikari_sheet *sheet)   \
   {                                                                            \
@@ -331,16 +93,10 @@ SHEET_VIEW(prev, last)
 int
 hikari_sheet_tileable_views(struct hikari_sheet *sheet)
 {
-  int nr_of_views = 0;
-
-  struct hikari_view *view;
-  wl_list_for_each (view, &sheet->views, sheet_views) {
-    if (hikari_view_is_tileable(view)) {
-      nr_of_views++;
-    }
-  }
+  assert(sheet->nr_of_dirty_tileable_views >= 0);
+  assert(sheet->nr_of_dirty_tileable_views <= sheet->nr_of_tileable_views);
 
-  return nr_of_views;
+  return sheet->nr_of_tileable_views - sheet->nr_of_dirty_tileable_views;
 }
 
 struct hikari_sheet *
@@ -401,10 +157,100 @@ raise_floating(struct hikari_sheet *sheet)
   }
 }
 
-void
-hikari_sheet_apply_split(struct hikari_sheet *sheet, struct hikari_split *split)
+static bool
+is_tiled_at(struct hikari_view *view,
+    struct hikari_layout *layout,
+    struct wlr_box *geometry)
+{
+  struct hikari_tile *tile = view->tile;
+
+  return tile != NULL && tile->layout == layout &&
+         view->maximized_state == NULL &&
+         wlr_box_equal(&tile->tile_geometry, geometry) &&
+         wlr_box_equal(&tile->view_geometry, geometry);
+}
+
+// views that are part of the layout keep their container when relayouting
+// incrementally, new views take the first container that has room left. This
+// way only containers that gained or lost views change their tiles. Containers
+// that lost views are refilled from the ones that follow them so the layout
+// never has a gap in front.
+static void
+assign_containers(struct hikari_layout *layout,
+    bool incremental,
+    struct hikari_view **views,
+    int nr_of_views,
+    int *capacities,
+    int *counts,
+    int nr_of_containers,
+    int *containers)
+{
+  memset(counts, 0, nr_of_containers * sizeof(int));
+
+  for (int i = 0; i < nr_of_views; i++) {
+    struct hikari_tile *tile = views[i]->tile;
+    int container = -1;
+
+    if (incremental && tile != NULL && tile->layout == layout &&
+        tile->container >= 0 && tile->container < nr_of_containers &&
+        counts[tile->container] < capacities[tile->container]) {
+      container = tile->container;
+      counts[container]++;
+    }
+
+    containers[i] = container;
+  }
+
+  int container = 0;
+  for (int i = 0; i < nr_of_views; i++) {
+    if (containers[i] != -1) {
+      continue;
+    }
+
+    while (container < nr_of_containers &&
+           counts[container] == capacities[container]) {
+      container++;
+    }
+
+    if (container == nr_of_containers) {
+      break;
+    }
+
+    containers[i] = container;
+    counts[container]++;
+  }
+
+  for (int container = 0; container < nr_of_containers; container++) {
+    while (counts[container] < capacities[container]) {
+      int donor = container + 1;
+      while (donor < nr_of_containers && counts[donor] == 0) {
+        donor++;
+      }
+
+      if (donor == nr_of_containers) {
+        return;
+      }
+
+      for (int i = 0; i < nr_of_views; i++) {
+        if (containers[i] == donor) {
+          containers[i] = container;
+          break;
+        }
+      }
+
+      counts[donor]--;
+      counts[container]++;
+    }
+  }
+}
+
+static void
+apply_split(struct hikari_sheet *sheet,
+    struct hikari_split *split,
+    bool keep_containers)
 {
   struct hikari_layout *layout;
+  bool incremental = false;
   if (sheet->layout != NULL) {
     layout = sheet->layout;
 
@@ -418,23 +264,141 @@ hikari_sheet_apply_split(struct hikari_sheet *sheet, struct hikari_split *split)
     if (layout->split != split) {
       hikari_split_free(layout->split);
       layout->split = hikari_split_copy(split);
+    } else {
+      incremental = keep_containers;
     }
   } else {
-    layout = hikari_malloc(sizeof(struct hikari_layout));
+    layout = hikari_tagged_malloc(
+        HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_layout));
     hikari_layout_init(layout, split, sheet);
 
     sheet->layout = layout;
   }
 
-  struct hikari_output *output = sheet->workspace->output;
-  struct wlr_box geometry = output->usable_area;
-  struct hikari_view *first = hikari_sheet_first_tileable_view(sheet);
+  int nr_of_views = hikari_sheet_tileable_views(sheet);
+
+  if (nr_of_views > 0) {
+    int nr_of_containers = hikari_split_nr_of_containers(layout->split);
+    int *capacities = hikari_malloc(nr_of_containers * sizeof(int));
+    int *counts = hikari_malloc(nr_of_containers * sizeof(int));
+    int *offsets = hikari_malloc(nr_of_containers * sizeof(int));
+    int *containers = hikari_malloc(nr_of_views * sizeof(int));
+    struct hikari_view **views =
+        hikari_malloc(nr_of_views * sizeof(struct hikari_view *));
+    struct hikari_view **placed_views =
+        hikari_malloc(nr_of_views * sizeof(struct hikari_view *));
+    struct wlr_box *view_geometries =
+        hikari_malloc(nr_of_views * sizeof(struct wlr_box));
+    struct wlr_box *tiles = hikari_malloc(nr_of_views * sizeof(struct wlr_box));
+
+    int i = 0;
+    struct hikari_view *view;
+    wl_list_for_each (view, &sheet->tileable_views, tileable_sheet_views) {
+      if (hikari_view_is_tileable(view)) {
+        views[i++] = view;
+      }
+    }
+
+    assert(i == nr_of_views);
+
+    hikari_split_capacities(layout->split, capacities);
+
+    assign_containers(layout,
+        incremental,
+        views,
+        nr_of_views,
+        capacities,
+        counts,
+        nr_of_containers,
+        containers);
+
+    int nr_of_placed_views = 0;
+    for (int container = 0; container < nr_of_containers; container++) {
+      offsets[container] = nr_of_placed_views;
+      nr_of_placed_views += counts[container];
+    }
+
+    for (i = 0; i < nr_of_views; i++) {
+      int container = containers[i];
+
+      if (container != -1) {
+        int n = offsets[container]++;
+
+        placed_views[n] = views[i];
+        view_geometries[n] = *hikari_view_geometry(views[i]);
+      }
+    }
+
+    // layout->split is a private copy, results are cached with the split that
+    // has been requested so they survive switching between layouts
+    struct hikari_output *output = sheet->workspace->output;
+    int nr_of_tiles = hikari_split_layout(layout->split,
+        hikari_split_cache(split),
+        &output->usable_area,
+        counts,
+        view_geometries,
+        hikari_configuration->gap,
+        hikari_configuration->border,
+        tiles);
+
+    assert(nr_of_tiles == nr_of_placed_views);
+
+    struct hikari_transaction *transaction = hikari_transaction_begin();
+
+    bool center = true;
+    int container = 0;
+    int container_end = counts[0];
+    for (i = 0; i < nr_of_tiles; i++) {
+      while (i == container_end) {
+        container_end += counts[++container];
+      }
+
+      view = placed_views[i];
+
+      if (hikari_view_is_hidden(view)) {
+        hikari_view_show(view);
+      }
+
+      if (is_tiled_at(view, layout, &tiles[i])) {
+        // keep the tile but preserve the order of the layout
+        view->tile->container = container;
+        wl_list_remove(&view->tile->layout_tiles);
+        wl_list_insert(layout->tiles.prev, &view->tile->layout_tiles);
+      } else {
+        hikari_view_tile(view, &tiles[i], container, center);
+      }
+
+      center = false;
+    }
+
+    hikari_transaction_end(transaction);
 
-  hikari_split_apply(layout->split, &geometry, first);
+    hikari_free(capacities);
+    hikari_free(counts);
+    hikari_free(offsets);
+    hikari_free(containers);
+    hikari_free(views);
+    hikari_free(placed_views);
+    hikari_free(view_geometries);
+    hikari_free(tiles);
+  }
 
   raise_floating(sheet);
 }
 
+void
+hikari_sheet_apply_split(struct hikari_sheet *sheet, struct hikari_split *split)
+{
+  apply_split(sheet, split, true);
+}
+
+void
+hikari_sheet_apply_split_in_order(
+    struct hikari_sheet *sheet, struct hikari_split *split)
+{
+  apply_split(sheet, split, false);
+}
+
 bool
 hikari_sheet_is_visible(struct hikari_sheet *sheet)
 {
@@ -482,3 +446,10 @@ hikari_sheet_show_invisible(struct hikari_sheet *sheet)
   SHOW_VIEWS(hikari_view_is_invisible(view));
 }
 #undef SHOW_VIEWS
+
+struct hikari_split *
+hikari_sheet_default_split(struct hikari_sheet *sheet)
+{
+  return hikari_configuration_lookup_layout(
+      hikari_configuration, 48 + sheet->nr);
+}
@@ -0,0 +1,173 @@
+#include <hikari/sheet_layout.h>
+
+#include <assert.h>
+
+#define LAYOUT_VIEWS(nr_of_views, frame, tiles)                                \
+  if (nr_of_views == 0) {                                                      \
+    return 0;                                                                  \
+  } else if (nr_of_views == 1) {                                               \
+    tiles[0] = *frame;                                                         \
+    return 1;                                                                  \
+  } else
+
+int
+hikari_sheet_single_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles)
+{
+  (void)gap;
+  (void)border_width;
+
+  if (nr_of_views == 0) {
+    return 0;
+  }
+
+  tiles[0] = *frame;
+
+  return 1;
+}
+
+int
+hikari_sheet_empty_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles)
+{
+  (void)frame;
+  (void)nr_of_views;
+  (void)gap;
+  (void)border_width;
+  (void)tiles;
+
+  return 0;
+}
+
+int
+hikari_sheet_full_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles)
+{
+  (void)gap;
+  (void)border_width;
+
+  for (int i = 0; i < nr_of_views; i++) {
+    tiles[i] = *frame;
+  }
+
+  return nr_of_views;
+}
+
+int
+hikari_sheet_grid_layout(struct wlr_box *frame,
+    int nr_of_views,
+    int gap,
+    int border_width,
+    struct wlr_box *tiles)
+{
+  int nr_of_rows = 1;
+  int nr_of_cols = 1;
+
+  for (int i = 1; i <= nr_of_views; i++) {
+    if (i > nr_of_rows * nr_of_cols) {
+      if (nr_of_cols > nr_of_rows) {
+        assert(nr_of_cols == nr_of_rows + 1);
+        nr_of_rows++;
+      } else {
+        nr_of_cols++;
+      }
+    }
+  }
+
+  LAYOUT_VIEWS(nr_of_views, frame, tiles)
+  {
+    int border = 2 * border_width;
+    int row_gaps = nr_of_rows - 1;
+    int col_gaps = nr_of_cols - 1;
+    int gaps_height = gap * row_gaps;
+    int gaps_width = gap * col_gaps;
+    int views_height = frame->height - border * nr_of_rows - gaps_height;
+    int views_width = frame->width - border * nr_of_cols - gaps_width;
+
+    int width = views_width / nr_of_cols;
+    int height = views_height / nr_of_rows;
+
+    int rest_width =
+        frame->width - border * col_gaps - gaps_width - width * nr_of_cols;
+
+    int rest_height =
+        frame->height - border * row_gaps - gaps_height - height * nr_of_rows;
+
+    struct wlr_box geometry = { .y = frame->y, .x = frame->x };
+    int nr_of_tiles = 0;
+
+    geometry.height = height + rest_height;
+    for (int g_y = 0; g_y < nr_of_rows; g_y++) {
+      if (g_y == 1) {
+        geometry.height = height;
+      }
+      geometry.width = width + rest_width;
+      for (int g_x = 0; g_x < nr_of_cols; g_x++) {
+        if (g_x == 1) {
+          geometry.width = width;
+        }
+
+        tiles[nr_of_tiles++] = geometry;
+        if (nr_of_tiles == nr_of_views) {
+          return nr_of_tiles;
+        }
+
+        geometry.x += gap + border + geometry.width;
+      }
+      geometry.x = frame->x;
+      geometry.y += gap + border + geometry.height;
+    }
+
+    return nr_of_tiles;
+  }
+}
+
+#define SPLIT_LAYOUT(name, x, y, width, height)                                \
+  int hikari_sheet_##name##_layout(struct wlr_box *frame,                      \
+      int nr_of_views,                                                         \
+      int gap,                                                                 \
+      int border_width,                                                        \
+      struct wlr_box *tiles)                                                   \
+  {                                                                            \
+    int border = 2 * border_width;                                             \
+    int gaps = nr_of_views - 1;                                                \
+    int gaps_##width = gap * gaps;                                             \
+                                                                               \
+    LAYOUT_VIEWS(nr_of_views, frame, tiles)                                    \
+    {                                                                          \
+      int views_width = frame->width - border * gaps - gaps_##width;           \
+      int width = views_width / nr_of_views;                                   \
+      int rest = views_width - width * nr_of_views;                            \
+                                                                               \
+      struct wlr_box geometry = { .x = frame->x,                               \
+        .y = frame->y,                                                         \
+        .width = width + rest,                                                 \
+        .height = frame->height };                                             \
+                                                                               \
+      tiles[0] = geometry;                                                     \
+                                                                               \
+      geometry.x += gap + border + width + rest;                               \
+      geometry.width = width;                                                  \
+      for (int n = 1; n < nr_of_views; n++) {                                  \
+        tiles[n] = geometry;                                                   \
+        geometry.x += gap + border + width;                                    \
+      }                                                                        \
+    }                                                                          \
+                                                                               \
+    return nr_of_views;                                                        \
+  }
+
+SPLIT_LAYOUT(queue, x, y, width, height)
+SPLIT_LAYOUT(stack, y, x, height, width)
+#undef SPLIT_LAYOUT
+
+#undef LAYOUT_VIEWS
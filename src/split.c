@@ -1,14 +1,56 @@
 #include <hikari/split.h>
 
-#include <hikari/color.h>
-#include <hikari/configuration.h>
+#include <assert.h>
+#include <string.h>
+
 #include <hikari/geometry.h>
-#include <hikari/view.h>
+#include <hikari/memory.h>
 
 const double hikari_split_scale_min = 0.1;
 const double hikari_split_scale_max = 0.9;
 const double hikari_split_scale_default = 0.5;
 
+#define CACHE_SIZE 8
+// trees up to this many nodes keep their subtree totals on the stack
+#define NR_OF_SMALL_TOTALS 63
+
+struct split_input {
+  int view;
+  bool height;
+  int value;
+};
+
+struct split_inputs {
+  struct wlr_box *view_geometries;
+  struct split_input *inputs;
+  int nr_of_inputs;
+};
+
+struct hikari_split_cache_entry {
+  bool valid;
+
+  struct wlr_box frame;
+  int *counts;
+  int gap;
+  int border;
+
+  struct split_input *inputs;
+  int nr_of_inputs;
+
+  struct wlr_box *tiles;
+  int nr_of_tiles;
+  int max_tiles;
+};
+
+struct hikari_split_cache {
+  struct hikari_split_cache_entry entries[CACHE_SIZE];
+  struct split_input *inputs;
+  int *totals;
+  int nr_of_containers;
+  int nr_of_scales;
+  int next;
+};
+
 static void
 flip_scale(struct hikari_split_scale *scale)
 {
@@ -27,10 +69,9 @@ flip_scale(struct hikari_split_scale *scale)
 #define SCALE(name)                                                            \
   static int split_scale_##name(struct hikari_split_scale *scale,              \
       struct wlr_box *src,                                                     \
-      struct hikari_view *first)                                               \
+      struct wlr_box *geometry,                                                \
+      int gap)                                                                 \
   {                                                                            \
-    int gap = hikari_configuration->gap;                                       \
-    struct wlr_box *geometry;                                                  \
     int name = 0;                                                              \
                                                                                \
     switch (scale->type) {                                                     \
@@ -40,7 +81,6 @@ flip_scale(struct hikari_split_scale *scale)
         break;                                                                 \
                                                                                \
       case HIKARI_SPLIT_SCALE_TYPE_DYNAMIC:                                    \
-        geometry = hikari_view_geometry(first);                                \
         name = hikari_geometry_scale_dynamic_##name(src,                       \
             geometry,                                                          \
             scale->scale.dynamic.min,                                          \
@@ -68,8 +108,8 @@ copy_split(struct hikari_split *split);
     struct hikari_split *first = copy_split(split_##name->first);              \
     struct hikari_split *second = copy_split(split_##name->second);            \
                                                                                \
-    struct hikari_split_##name *ret =                                          \
-        hikari_malloc(sizeof(struct hikari_split_##name));                     \
+    struct hikari_split_##name *ret = hikari_tagged_malloc(                    \
+        HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_##name));            \
                                                                                \
     hikari_split_##name##_init(                                                \
         ret, &split_##name->scale, split_##name->orientation, first, second);  \
@@ -84,8 +124,8 @@ COPY(horizontal, top, bottom)
 static struct hikari_split *
 copy_split_container(struct hikari_split_container *split_container)
 {
-  struct hikari_split_container *ret =
-      hikari_malloc(sizeof(struct hikari_split_container));
+  struct hikari_split_container *ret = hikari_tagged_malloc(
+      HIKARI_MEMORY_LAYOUTS, sizeof(struct hikari_split_container));
 
   hikari_split_container_init(
       ret, split_container->max, split_container->layout);
@@ -124,38 +164,141 @@ hikari_split_copy(struct hikari_split *split)
   return copy_split(split);
 }
 
-static struct hikari_view *
-apply_split(struct hikari_split *split,
+static void
+split_children(struct hikari_split *split,
+    struct hikari_split **first,
+    struct hikari_split **second)
+{
+  switch (split->type) {
+    case HIKARI_SPLIT_TYPE_VERTICAL: {
+      struct hikari_split_vertical *split_vertical =
+          (struct hikari_split_vertical *)split;
+
+      if (split_vertical->orientation ==
+          HIKARI_VERTICAL_SPLIT_ORIENTATION_LEFT) {
+        *first = split_vertical->left;
+        *second = split_vertical->right;
+      } else {
+        *first = split_vertical->right;
+        *second = split_vertical->left;
+      }
+    } break;
+
+    case HIKARI_SPLIT_TYPE_HORIZONTAL: {
+      struct hikari_split_horizontal *split_horizontal =
+          (struct hikari_split_horizontal *)split;
+
+      if (split_horizontal->orientation ==
+          HIKARI_HORIZONTAL_SPLIT_ORIENTATION_TOP) {
+        *first = split_horizontal->top;
+        *second = split_horizontal->bottom;
+      } else {
+        *first = split_horizontal->bottom;
+        *second = split_horizontal->top;
+      }
+    } break;
+
+    case HIKARI_SPLIT_TYPE_CONTAINER:
+      *first = NULL;
+      *second = NULL;
+      break;
+  }
+}
+
+// totals holds the number of views of every subtree in pre-order, it is
+// computed once per layout so empty subtrees can be skipped without recounting
+static int
+sum_views(struct hikari_split *split, int **counts, int **totals)
+{
+  int *total = (*totals)++;
+
+  if (split->type == HIKARI_SPLIT_TYPE_CONTAINER) {
+    *total = *(*counts)++;
+    return *total;
+  }
+
+  struct hikari_split *first, *second;
+  split_children(split, &first, &second);
+
+  int nr_of_views = sum_views(first, counts, totals);
+  nr_of_views += sum_views(second, counts, totals);
+
+  *total = nr_of_views;
+
+  return nr_of_views;
+}
+
+static void
+skip_split(struct hikari_split *split, int **counts, int **totals)
+{
+  (*totals)++;
+
+  if (split->type == HIKARI_SPLIT_TYPE_CONTAINER) {
+    (*counts)++;
+    return;
+  }
+
+  struct hikari_split *first, *second;
+  split_children(split, &first, &second);
+
+  skip_split(first, counts, totals);
+  skip_split(second, counts, totals);
+}
+
+static void
+record_input(
+    struct split_inputs *inputs, struct wlr_box *view_geometry, bool height)
+{
+  struct split_input *input = &inputs->inputs[inputs->nr_of_inputs++];
+
+  input->view = view_geometry - inputs->view_geometries;
+  input->height = height;
+  input->value = height ? view_geometry->height : view_geometry->width;
+}
+
+static int
+layout_split(struct hikari_split *split,
     struct wlr_box *geometry,
-    struct hikari_view *first,
-    bool *center)
+    int **counts,
+    int **totals,
+    struct wlr_box *view_geometries,
+    int gap,
+    int border,
+    struct wlr_box *tiles,
+    struct split_inputs *inputs)
 {
-  if (first == NULL) {
-    return NULL;
+  if (**totals == 0) {
+    skip_split(split, counts, totals);
+    return 0;
   }
 
-  struct hikari_view *view = first;
+  (*totals)++;
+
+  struct wlr_box first_geometry, second_geometry;
   switch (split->type) {
     case HIKARI_SPLIT_TYPE_VERTICAL: {
       struct wlr_box left, right;
       struct hikari_split_vertical *split_vertical =
           (struct hikari_split_vertical *)split;
 
-      int width = split_scale_width(&split_vertical->scale, geometry, first);
-      int gap = hikari_configuration->gap + hikari_configuration->border * 2;
+      int width = split_scale_width(
+          &split_vertical->scale, geometry, &view_geometries[0], gap);
 
-      hikari_geometry_split_vertical(geometry, width, gap, &left, &right);
+      if (inputs != NULL &&
+          split_vertical->scale.type == HIKARI_SPLIT_SCALE_TYPE_DYNAMIC) {
+        record_input(inputs, &view_geometries[0], false);
+      }
 
-      switch (split_vertical->orientation) {
-        case HIKARI_VERTICAL_SPLIT_ORIENTATION_LEFT:
-          view = apply_split(split_vertical->left, &left, view, center);
-          view = apply_split(split_vertical->right, &right, view, center);
-          break;
+      hikari_geometry_split_vertical(
+          geometry, width, gap + border * 2, &left, &right);
 
-        case HIKARI_VERTICAL_SPLIT_ORIENTATION_RIGHT:
-          view = apply_split(split_vertical->right, &right, view, center);
-          view = apply_split(split_vertical->left, &left, view, center);
-          break;
+      if (split_vertical->orientation ==
+          HIKARI_VERTICAL_SPLIT_ORIENTATION_LEFT) {
+        first_geometry = left;
+        second_geometry = right;
+      } else {
+        first_geometry = right;
+        second_geometry = left;
       }
     } break;
 
@@ -164,52 +307,316 @@ apply_split(struct hikari_split *split,
       struct hikari_split_horizontal *split_horizontal =
           (struct hikari_split_horizontal *)split;
 
-      int height =
-          split_scale_height(&split_horizontal->scale, geometry, first);
-      int gap = hikari_configuration->gap + hikari_configuration->border * 2;
+      int height = split_scale_height(
+          &split_horizontal->scale, geometry, &view_geometries[0], gap);
 
-      hikari_geometry_split_horizontal(geometry, height, gap, &top, &bottom);
+      if (inputs != NULL &&
+          split_horizontal->scale.type == HIKARI_SPLIT_SCALE_TYPE_DYNAMIC) {
+        record_input(inputs, &view_geometries[0], true);
+      }
 
-      switch (split_horizontal->orientation) {
-        case HIKARI_HORIZONTAL_SPLIT_ORIENTATION_TOP:
-          view = apply_split(split_horizontal->top, &top, view, center);
-          view = apply_split(split_horizontal->bottom, &bottom, view, center);
-          break;
+      hikari_geometry_split_horizontal(
+          geometry, height, gap + border * 2, &top, &bottom);
 
-        case HIKARI_HORIZONTAL_SPLIT_ORIENTATION_BOTTOM:
-          view = apply_split(split_horizontal->bottom, &bottom, view, center);
-          view = apply_split(split_horizontal->top, &top, view, center);
-          break;
+      if (split_horizontal->orientation ==
+          HIKARI_HORIZONTAL_SPLIT_ORIENTATION_TOP) {
+        first_geometry = top;
+        second_geometry = bottom;
+      } else {
+        first_geometry = bottom;
+        second_geometry = top;
       }
     } break;
 
     case HIKARI_SPLIT_TYPE_CONTAINER: {
       struct hikari_split_container *container =
           (struct hikari_split_container *)split;
-      container->geometry = *geometry;
-      view = container->layout(
-          view->sheet, view, geometry, container->max, center);
-    } break;
+      int nr_of_views = *(*counts)++;
+
+      assert(nr_of_views <= container->max);
+
+      return container->layout(geometry, nr_of_views, gap, border, tiles);
+    }
+  }
+
+  struct hikari_split *first, *second;
+  split_children(split, &first, &second);
+
+  int nr_of_tiles = layout_split(first,
+      &first_geometry,
+      counts,
+      totals,
+      view_geometries,
+      gap,
+      border,
+      tiles,
+      inputs);
+
+  nr_of_tiles += layout_split(second,
+      &second_geometry,
+      counts,
+      totals,
+      view_geometries + nr_of_tiles,
+      gap,
+      border,
+      tiles + nr_of_tiles,
+      inputs);
+
+  return nr_of_tiles;
+}
+
+static bool
+cache_entry_matches(struct hikari_split_cache *cache,
+    struct hikari_split_cache_entry *entry,
+    struct wlr_box *frame,
+    int *counts,
+    struct wlr_box *view_geometries,
+    int gap,
+    int border)
+{
+  if (!entry->valid || entry->gap != gap || entry->border != border ||
+      !wlr_box_equal(&entry->frame, frame) ||
+      memcmp(entry->counts, counts, cache->nr_of_containers * sizeof(int))) {
+    return false;
+  }
+
+  for (int i = 0; i < entry->nr_of_inputs; i++) {
+    struct split_input *input = &entry->inputs[i];
+    struct wlr_box *view_geometry = &view_geometries[input->view];
+
+    int value = input->height ? view_geometry->height : view_geometry->width;
+    if (value != input->value) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static void
+cache_store(struct hikari_split_cache *cache,
+    struct wlr_box *frame,
+    int *counts,
+    int gap,
+    int border,
+    struct split_inputs *inputs,
+    struct wlr_box *tiles,
+    int nr_of_tiles)
+{
+  struct hikari_split_cache_entry *entry = &cache->entries[cache->next];
+  cache->next = (cache->next + 1) % CACHE_SIZE;
+
+  if (nr_of_tiles > entry->max_tiles) {
+    hikari_tagged_free(entry->tiles);
+    entry->tiles = hikari_tagged_malloc(
+        HIKARI_MEMORY_LAYOUTS, nr_of_tiles * sizeof(struct wlr_box));
+    entry->max_tiles = nr_of_tiles;
+  }
+
+  if (inputs->nr_of_inputs > 0 && entry->inputs == NULL) {
+    entry->inputs = hikari_tagged_malloc(HIKARI_MEMORY_LAYOUTS,
+        cache->nr_of_scales * sizeof(struct split_input));
+  }
+
+  if (entry->counts == NULL) {
+    entry->counts = hikari_tagged_malloc(
+        HIKARI_MEMORY_LAYOUTS, cache->nr_of_containers * sizeof(int));
+  }
+
+  entry->valid = true;
+  entry->frame = *frame;
+  entry->gap = gap;
+  entry->border = border;
+  entry->nr_of_inputs = inputs->nr_of_inputs;
+  entry->nr_of_tiles = nr_of_tiles;
+
+  memcpy(entry->counts, counts, cache->nr_of_containers * sizeof(int));
+
+  if (inputs->nr_of_inputs > 0) {
+    memcpy(entry->inputs,
+        inputs->inputs,
+        inputs->nr_of_inputs * sizeof(struct split_input));
   }
 
-  return view;
+  if (nr_of_tiles > 0) {
+    memcpy(entry->tiles, tiles, nr_of_tiles * sizeof(struct wlr_box));
+  }
+}
+
+int
+hikari_split_layout(struct hikari_split *split,
+    struct hikari_split_cache *cache,
+    struct wlr_box *frame,
+    int *counts,
+    struct wlr_box *view_geometries,
+    int gap,
+    int border,
+    struct wlr_box *tiles)
+{
+  struct wlr_box geometry = *frame;
+  int *container_counts = counts;
+  int *subtree_totals;
+
+  hikari_geometry_shrink(&geometry, gap + border);
+
+  if (cache == NULL) {
+    int small_totals[NR_OF_SMALL_TOTALS];
+    int nr_of_nodes = 2 * hikari_split_nr_of_containers(split) - 1;
+    int *totals = nr_of_nodes <= NR_OF_SMALL_TOTALS
+                      ? small_totals
+                      : hikari_malloc(nr_of_nodes * sizeof(int));
+
+    subtree_totals = totals;
+    sum_views(split, &container_counts, &subtree_totals);
+
+    container_counts = counts;
+    subtree_totals = totals;
+    int nr_of_tiles = layout_split(split,
+        &geometry,
+        &container_counts,
+        &subtree_totals,
+        view_geometries,
+        gap,
+        border,
+        tiles,
+        NULL);
+
+    if (totals != small_totals) {
+      hikari_free(totals);
+    }
+
+    return nr_of_tiles;
+  }
+
+  for (int i = 0; i < CACHE_SIZE; i++) {
+    struct hikari_split_cache_entry *entry = &cache->entries[i];
+
+    if (cache_entry_matches(
+            cache, entry, frame, counts, view_geometries, gap, border)) {
+      memcpy(tiles, entry->tiles, entry->nr_of_tiles * sizeof(struct wlr_box));
+      return entry->nr_of_tiles;
+    }
+  }
+
+  struct split_inputs inputs = { .view_geometries = view_geometries,
+    .inputs = cache->inputs,
+    .nr_of_inputs = 0 };
+
+  subtree_totals = cache->totals;
+  sum_views(split, &container_counts, &subtree_totals);
+
+  container_counts = counts;
+  subtree_totals = cache->totals;
+  int nr_of_tiles = layout_split(split,
+      &geometry,
+      &container_counts,
+      &subtree_totals,
+      view_geometries,
+      gap,
+      border,
+      tiles,
+      &inputs);
+
+  assert(inputs.nr_of_inputs <= cache->nr_of_scales);
+  assert(container_counts - counts == cache->nr_of_containers);
+  assert(subtree_totals - cache->totals ==
+         cache->nr_of_containers + cache->nr_of_scales);
+
+  cache_store(cache, frame, counts, gap, border, &inputs, tiles, nr_of_tiles);
+
+  return nr_of_tiles;
+}
+
+static void
+collect_capacities(struct hikari_split *split, int **capacities)
+{
+  if (split->type == HIKARI_SPLIT_TYPE_CONTAINER) {
+    struct hikari_split_container *container =
+        (struct hikari_split_container *)split;
+
+    *(*capacities)++ = container->max;
+  } else {
+    struct hikari_split *first, *second;
+    split_children(split, &first, &second);
+
+    collect_capacities(first, capacities);
+    collect_capacities(second, capacities);
+  }
 }
 
 void
-hikari_split_apply(struct hikari_split *split,
-    struct wlr_box *geometry,
-    struct hikari_view *first)
+hikari_split_capacities(struct hikari_split *split, int *capacities)
 {
-  if (first == NULL) {
-    return;
+  collect_capacities(split, &capacities);
+}
+
+int
+hikari_split_nr_of_containers(struct hikari_split *split)
+{
+  if (split->type == HIKARI_SPLIT_TYPE_CONTAINER) {
+    return 1;
+  }
+
+  struct hikari_split *first, *second;
+  split_children(split, &first, &second);
+
+  return hikari_split_nr_of_containers(first) +
+         hikari_split_nr_of_containers(second);
+}
+
+static int
+count_scales(struct hikari_split *split)
+{
+  if (split->type == HIKARI_SPLIT_TYPE_CONTAINER) {
+    return 0;
+  }
+
+  struct hikari_split *first, *second;
+  split_children(split, &first, &second);
+
+  return 1 + count_scales(first) + count_scales(second);
+}
+
+struct hikari_split_cache *
+hikari_split_cache(struct hikari_split *split)
+{
+  if (split->cache == NULL) {
+    struct hikari_split_cache *cache = hikari_tagged_calloc(
+        HIKARI_MEMORY_LAYOUTS, 1, sizeof(struct hikari_split_cache));
+
+    cache->nr_of_containers = hikari_split_nr_of_containers(split);
+    cache->nr_of_scales = count_scales(split);
+    if (cache->nr_of_scales > 0) {
+      cache->inputs = hikari_tagged_malloc(HIKARI_MEMORY_LAYOUTS,
+          cache->nr_of_scales * sizeof(struct split_input));
+    }
+
+    // one total per node, scales are the inner nodes
+    cache->totals = hikari_tagged_malloc(HIKARI_MEMORY_LAYOUTS,
+        (cache->nr_of_containers + cache->nr_of_scales) * sizeof(int));
+
+    split->cache = cache;
   }
 
-  bool center = true;
+  return split->cache;
+}
 
-  hikari_geometry_shrink(
-      geometry, hikari_configuration->gap + hikari_configuration->border);
+static void
+free_cache(struct hikari_split_cache *cache)
+{
+  if (cache == NULL) {
+    return;
+  }
 
-  apply_split(split, geometry, first, &center);
+  for (int i = 0; i < CACHE_SIZE; i++) {
+    hikari_tagged_free(cache->entries[i].counts);
+    hikari_tagged_free(cache->entries[i].inputs);
+    hikari_tagged_free(cache->entries[i].tiles);
+  }
+
+  hikari_tagged_free(cache->inputs);
+  hikari_tagged_free(cache->totals);
+  hikari_tagged_free(cache);
 }
 
 void
@@ -218,9 +625,9 @@ hikari_split_container_init(struct hikari_split_container *container,
     hikari_layout_func layout)
 {
   container->split.type = HIKARI_SPLIT_TYPE_CONTAINER;
+  container->split.cache = NULL;
   container->max = nr_of_views;
   container->layout = layout;
-  container->geometry = (struct wlr_box){ 0 };
 }
 
 void
@@ -231,6 +638,7 @@ hikari_split_vertical_init(struct hikari_split_vertical *split_vertical,
     struct hikari_split *right)
 {
   split_vertical->split.type = HIKARI_SPLIT_TYPE_VERTICAL;
+  split_vertical->split.cache = NULL;
   split_vertical->orientation = orientation;
   split_vertical->left = left;
   split_vertical->right = right;
@@ -250,6 +658,7 @@ hikari_split_horizontal_init(struct hikari_split_horizontal *split_horizontal,
     struct hikari_split *bottom)
 {
   split_horizontal->split.type = HIKARI_SPLIT_TYPE_HORIZONTAL;
+  split_horizontal->split.cache = NULL;
   split_horizontal->orientation = orientation;
   split_horizontal->top = top;
   split_horizontal->bottom = bottom;
@@ -265,6 +674,8 @@ hikari_split_horizontal_init(struct hikari_split_horizontal *split_horizontal,
 void
 hikari_split_free(struct hikari_split *split)
 {
+  free_cache(split->cache);
+
   switch (split->type) {
     case HIKARI_SPLIT_TYPE_VERTICAL: {
       struct hikari_split_vertical *split_vertical =
@@ -272,7 +683,7 @@ hikari_split_free(struct hikari_split *split)
 
       hikari_split_free(split_vertical->left);
       hikari_split_free(split_vertical->right);
-      hikari_free(split_vertical);
+      hikari_tagged_free(split_vertical);
     } break;
 
     case HIKARI_SPLIT_TYPE_HORIZONTAL: {
@@ -281,21 +692,14 @@ hikari_split_free(struct hikari_split *split)
 
       hikari_split_free(split_horizontal->top);
       hikari_split_free(split_horizontal->bottom);
-      hikari_free(split_horizontal);
+      hikari_tagged_free(split_horizontal);
     } break;
 
     case HIKARI_SPLIT_TYPE_CONTAINER: {
       struct hikari_split_container *container =
           (struct hikari_split_container *)split;
 
-      hikari_free(container);
+      hikari_tagged_free(container);
     } break;
   }
 }
-
-struct hikari_split *
-hikari_sheet_default_split(struct hikari_sheet *sheet)
-{
-  return hikari_configuration_lookup_layout(
-      hikari_configuration, 48 + sheet->nr);
-}
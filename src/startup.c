@@ -0,0 +1,114 @@
+#include <hikari/startup.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+#include <hikari/log.h>
+
+#define MAX_PHASES 32
+
+struct phase {
+  const char *name;
+  uint64_t end_nsec;
+};
+
+static struct {
+  bool running;
+  uint64_t begin_nsec;
+  uint64_t autostart_nsec;
+
+  struct phase phases[MAX_PHASES];
+  int nr_of_phases;
+} startup = { .running = false };
+
+static uint64_t
+now_nsec(void)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static double
+to_msec(uint64_t nsec)
+{
+  return nsec / 1000000.0;
+}
+
+void
+hikari_startup_begin(void)
+{
+  startup.running = true;
+  startup.begin_nsec = now_nsec();
+  startup.autostart_nsec = 0;
+  startup.nr_of_phases = 0;
+}
+
+void
+hikari_startup_phase(const char *name)
+{
+  if (!startup.running || startup.nr_of_phases == MAX_PHASES) {
+    return;
+  }
+
+  struct phase *phase = &startup.phases[startup.nr_of_phases++];
+
+  phase->name = name;
+  phase->end_nsec = now_nsec();
+}
+
+void
+hikari_startup_autostart(void)
+{
+  if (!startup.running) {
+    return;
+  }
+
+  startup.autostart_nsec = now_nsec();
+}
+
+void
+hikari_startup_first_frame(void)
+{
+  if (!startup.running) {
+    return;
+  }
+
+  uint64_t first_frame_nsec = now_nsec();
+  startup.running = false;
+
+  char report[1024] = "";
+  size_t length = 0;
+  uint64_t start_nsec = startup.begin_nsec;
+
+  for (int i = 0; i < startup.nr_of_phases; i++) {
+    struct phase *phase = &startup.phases[i];
+
+    int n = snprintf(report + length,
+        sizeof(report) - length,
+        " %s=%.1fms",
+        phase->name,
+        to_msec(phase->end_nsec - start_nsec));
+
+    if (n < 0 || (size_t)n >= sizeof(report) - length) {
+      break;
+    }
+
+    length += n;
+    start_nsec = phase->end_nsec;
+  }
+
+  if (startup.autostart_nsec != 0) {
+    hikari_log_info("startup:%s autostart=%.1fms first-frame=%.1fms",
+        report,
+        to_msec(startup.autostart_nsec - startup.begin_nsec),
+        to_msec(first_frame_nsec - startup.begin_nsec));
+  } else {
+    hikari_log_info("startup:%s first-frame=%.1fms",
+        report,
+        to_msec(first_frame_nsec - startup.begin_nsec));
+  }
+}
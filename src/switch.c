@@ -1,6 +1,7 @@
 #include <hikari/switch.h>
 
 #include <hikari/action.h>
+#include <hikari/input_log.h>
 #include <hikari/memory.h>
 #include <hikari/server.h>
 #include <hikari/switch_config.h>
@@ -26,14 +27,16 @@ destroy_handler(struct wl_listener *listener, void *data)
   struct hikari_switch *swtch = wl_container_of(listener, swtch, destroy);
 
   hikari_switch_fini(swtch);
-  hikari_free(swtch);
+  hikari_tagged_free(swtch);
 }
 
 static void
 toggle_handler(struct wl_listener *listener, void *data)
 {
-  (void)data;
   struct hikari_switch *swtch = wl_container_of(listener, swtch, toggle);
+  struct wlr_switch_toggle_event *event = data;
+
+  hikari_input_log_switch(swtch->device->name, event);
 
   if (swtch->state == WLR_SWITCH_STATE_OFF) {
     struct hikari_event_action *begin = &swtch->action->begin;
@@ -3,6 +3,7 @@
 #include <wayland-util.h>
 
 #include <hikari/layout.h>
+#include <hikari/memory.h>
 #include <hikari/sheet.h>
 #include <hikari/view.h>
 
@@ -17,6 +18,7 @@ hikari_tile_init(struct hikari_tile *tile,
   tile->layout = layout;
   tile->tile_geometry = *tile_geometry;
   tile->view_geometry = *view_geometry;
+  tile->container = -1;
 }
 
 #define CYCLE_LAYOUT(link)                                                     \
@@ -59,7 +61,7 @@ hikari_tile_detach(struct hikari_tile *tile)
     if (wl_list_empty(&layout->tiles)) {
       layout->sheet->layout = NULL;
       hikari_layout_fini(layout);
-      hikari_free(layout);
+      hikari_tagged_free(layout);
     }
     tile->layout = NULL;
   }
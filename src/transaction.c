@@ -0,0 +1,162 @@
+#include <hikari/transaction.h>
+
+#include <assert.h>
+
+#include <hikari/configuration.h>
+#include <hikari/memory.h>
+#include <hikari/server.h>
+#include <hikari/view.h>
+
+static struct hikari_transaction *collecting = NULL;
+
+static void
+apply(struct hikari_transaction *transaction)
+{
+  assert(!transaction->collecting);
+
+  wl_event_source_remove(transaction->timeout);
+
+  // commit all acknowledged operations in one go so they share a frame,
+  // views that did not make it in time commit on their own later on
+  struct hikari_view *view, *view_temp;
+  wl_list_for_each_safe (view,
+      view_temp,
+      &transaction->members,
+      transaction.transaction_members) {
+    struct hikari_transaction_member *member = &view->transaction;
+
+    wl_list_remove(&member->transaction_members);
+    member->transaction = NULL;
+
+    if (member->ready) {
+      member->ready = false;
+      hikari_view_commit_pending_operation(view, &member->geometry);
+    }
+  }
+
+  hikari_free(transaction);
+}
+
+static int
+timeout_handler(void *data)
+{
+  struct hikari_transaction *transaction = data;
+
+  apply(transaction);
+
+  return 0;
+}
+
+void
+hikari_transaction_member_init(struct hikari_transaction_member *member)
+{
+  member->transaction = NULL;
+  member->ready = false;
+  wl_list_init(&member->transaction_members);
+}
+
+struct hikari_transaction *
+hikari_transaction_begin(void)
+{
+  if (collecting != NULL || hikari_configuration->layout_timeout == 0) {
+    return NULL;
+  }
+
+  struct hikari_transaction *transaction =
+      hikari_malloc(sizeof(struct hikari_transaction));
+
+  wl_list_init(&transaction->members);
+  transaction->pending = 0;
+  transaction->collecting = true;
+  transaction->timeout = wl_event_loop_add_timer(
+      hikari_server.event_loop, timeout_handler, transaction);
+
+  collecting = transaction;
+
+  return transaction;
+}
+
+void
+hikari_transaction_end(struct hikari_transaction *transaction)
+{
+  if (transaction == NULL) {
+    return;
+  }
+
+  assert(collecting == transaction);
+
+  collecting = NULL;
+  transaction->collecting = false;
+
+  if (transaction->pending == 0) {
+    apply(transaction);
+  } else {
+    wl_event_source_timer_update(
+        transaction->timeout, hikari_configuration->layout_timeout);
+  }
+}
+
+void
+hikari_transaction_add(struct hikari_view *view)
+{
+  struct hikari_transaction_member *member = &view->transaction;
+
+  if (collecting == NULL || member->transaction != NULL) {
+    return;
+  }
+
+  member->transaction = collecting;
+  member->ready = false;
+  wl_list_insert(collecting->members.prev, &member->transaction_members);
+  collecting->pending++;
+}
+
+bool
+hikari_transaction_defer(struct hikari_view *view, struct wlr_box *geometry)
+{
+  struct hikari_transaction_member *member = &view->transaction;
+  struct hikari_transaction *transaction = member->transaction;
+
+  if (transaction == NULL) {
+    return false;
+  }
+
+  member->geometry = *geometry;
+
+  if (!member->ready) {
+    member->ready = true;
+    transaction->pending--;
+
+    if (transaction->pending == 0 && !transaction->collecting) {
+      apply(transaction);
+    }
+  }
+
+  return true;
+}
+
+void
+hikari_transaction_remove(struct hikari_view *view)
+{
+  struct hikari_transaction_member *member = &view->transaction;
+  struct hikari_transaction *transaction = member->transaction;
+
+  if (transaction == NULL) {
+    return;
+  }
+
+  wl_list_remove(&member->transaction_members);
+  wl_list_init(&member->transaction_members);
+  member->transaction = NULL;
+
+  if (!member->ready) {
+    transaction->pending--;
+
+    // do not commit other views while this one is being torn down
+    if (transaction->pending == 0 && !transaction->collecting) {
+      wl_event_source_timer_update(transaction->timeout, 1);
+    }
+  }
+
+  member->ready = false;
+}
@@ -11,6 +11,7 @@
 #include <hikari/geometry.h>
 #include <hikari/group.h>
 #include <hikari/indicator.h>
+#include <hikari/latency.h>
 #include <hikari/layout.h>
 #include <hikari/log.h>
 #include <hikari/mark.h>
@@ -20,6 +21,7 @@
 #include <hikari/server.h>
 #include <hikari/sheet.h>
 #include <hikari/tile.h>
+#include <hikari/transaction.h>
 #include <hikari/view_config.h>
 #include <hikari/workspace.h>
 #include <hikari/xdg_view.h>
@@ -48,6 +50,86 @@ VIEW(first, next)
 VIEW(last, prev)
 #undef VIEW
 
+static inline bool
+is_layout_candidate(struct hikari_view *view)
+{
+  return !hikari_view_is_floating(view) && !hikari_view_is_invisible(view);
+}
+
+static void
+unlink_tileable(struct hikari_view *view)
+{
+  struct hikari_sheet *sheet = view->tileable_sheet;
+
+  if (sheet != NULL) {
+    wl_list_remove(&view->tileable_sheet_views);
+    wl_list_init(&view->tileable_sheet_views);
+    sheet->nr_of_tileable_views--;
+    if (hikari_view_is_dirty(view)) {
+      sheet->nr_of_dirty_tileable_views--;
+    }
+    view->tileable_sheet = NULL;
+  }
+}
+
+// keeps the sheet's tileable views in the same order as its views, has to be
+// called whenever the view moved to the top or the bottom of its sheet
+static void
+link_tileable(struct hikari_view *view, bool top)
+{
+  struct hikari_sheet *sheet = view->sheet;
+
+  unlink_tileable(view);
+
+  if (is_layout_candidate(view)) {
+    struct wl_list *link =
+        top ? &sheet->tileable_views : sheet->tileable_views.prev;
+
+    wl_list_insert(link, &view->tileable_sheet_views);
+    sheet->nr_of_tileable_views++;
+    if (hikari_view_is_dirty(view)) {
+      sheet->nr_of_dirty_tileable_views++;
+    }
+    view->tileable_sheet = sheet;
+  }
+}
+
+// floating and invisible state changes do not move the view so it has to be
+// inserted after the closest tileable view above it
+static void
+refresh_tileable(struct hikari_view *view)
+{
+  struct hikari_sheet *sheet = view->sheet;
+
+  if (sheet == NULL || !hikari_view_is_mapped(view)) {
+    return;
+  }
+
+  if (!is_layout_candidate(view)) {
+    unlink_tileable(view);
+  } else if (view->tileable_sheet == NULL) {
+    struct wl_list *link = &sheet->tileable_views;
+
+    struct hikari_view *above;
+    wl_list_for_each (above, &sheet->views, sheet_views) {
+      if (above == view) {
+        break;
+      }
+
+      if (above->tileable_sheet == sheet) {
+        link = &above->tileable_sheet_views;
+      }
+    }
+
+    wl_list_insert(link, &view->tileable_sheet_views);
+    sheet->nr_of_tileable_views++;
+    if (hikari_view_is_dirty(view)) {
+      sheet->nr_of_dirty_tileable_views++;
+    }
+    view->tileable_sheet = sheet;
+  }
+}
+
 static void
 move_to_top(struct hikari_view *view)
 {
@@ -56,6 +138,7 @@ move_to_top(struct hikari_view *view)
 
   wl_list_remove(&view->sheet_views);
   wl_list_insert(&view->sheet->views, &view->sheet_views);
+  link_tileable(view, true);
 
   wl_list_remove(&view->group_views);
   wl_list_insert(&view->group->views, &view->group_views);
@@ -121,6 +204,8 @@ move_view_constrained(
 static void
 move_view(struct hikari_view *view, struct wlr_box *geometry, int x, int y)
 {
+  hikari_latency_mark(HIKARI_LATENCY_MOVE);
+
   if (view->maximized_state != NULL) {
     struct wlr_box *usable_area;
 
@@ -239,11 +324,13 @@ remove_from_group(struct hikari_view *view)
 static void
 cancel_tile(struct hikari_view *view)
 {
+  hikari_transaction_remove(view);
+
   if (hikari_view_is_tiling(view)) {
     struct hikari_tile *tile = view->pending_operation.tile;
 
     hikari_tile_detach(tile);
-    hikari_free(tile);
+    hikari_pool_free(HIKARI_POOL_TILE, tile);
     view->pending_operation.tile = NULL;
   }
 }
@@ -267,6 +354,9 @@ resize(struct hikari_view *view,
     struct hikari_operation *op,
     void (*f)(struct hikari_view *, struct hikari_operation *))
 {
+  hikari_latency_mark(HIKARI_LATENCY_RESIZE);
+  hikari_latency_save(&op->latency);
+
 #ifdef HAVE_XWAYLAND
   if (view->move_resize != NULL) {
     op->serial = 0;
@@ -343,7 +433,7 @@ commit_reset(struct hikari_view *view, struct hikari_operation *operation)
 
   if (hikari_view_is_tiled(view)) {
     assert(!hikari_tile_is_attached(view->tile));
-    hikari_free(view->tile);
+    hikari_pool_free(HIKARI_POOL_TILE, view->tile);
     view->tile = NULL;
   }
 
@@ -423,6 +513,7 @@ hikari_view_init(
   view->mark = NULL;
   view->surface = NULL;
   view->maximized_state = NULL;
+  view->tileable_sheet = NULL;
   view->output = NULL;
   view->group = NULL;
   view->title = NULL;
@@ -437,10 +528,12 @@ hikari_view_init(
 
   hikari_view_unset_dirty(view);
   view->pending_operation.tile = NULL;
+  hikari_transaction_member_init(&view->transaction);
 
   view->decoration.wlr_decoration = NULL;
 
   wl_list_init(&view->children);
+  wl_list_init(&view->tileable_sheet_views);
 }
 
 void
@@ -468,6 +561,8 @@ hikari_view_fini(struct hikari_view *view)
     wl_list_remove(&view->output_views);
   }
 
+  unlink_tileable(view);
+
   if (view->maximized_state != NULL) {
     hikari_maximized_state_destroy(view->maximized_state);
   }
@@ -479,7 +574,7 @@ hikari_view_fini(struct hikari_view *view)
   if (hikari_view_is_tiled(view)) {
     struct hikari_tile *tile = view->tile;
     hikari_tile_detach(tile);
-    hikari_free(tile);
+    hikari_pool_free(HIKARI_POOL_TILE, tile);
     view->tile = NULL;
   }
 
@@ -795,7 +890,8 @@ new_subsurface_handler(struct wl_listener *listener, void *data)
   struct wlr_subsurface *wlr_subsurface = data;
 
   struct hikari_view_subsurface *view_subsurface =
-      hikari_malloc(sizeof(struct hikari_view_subsurface));
+      hikari_pool_alloc(HIKARI_POOL_VIEW_SUBSURFACE,
+          sizeof(struct hikari_view_subsurface));
 
   hikari_view_subsurface_init(view_subsurface, view, wlr_subsurface);
 }
@@ -828,14 +924,14 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
   wl_list_for_each (
       wlr_subsurface, &surface->current.subsurfaces_below, current.link) {
     struct hikari_view_subsurface *subsurface =
-        (struct hikari_view_subsurface *)hikari_malloc(
+        hikari_pool_alloc(HIKARI_POOL_VIEW_SUBSURFACE,
             sizeof(struct hikari_view_subsurface));
     hikari_view_subsurface_init(subsurface, view, wlr_subsurface);
   }
   wl_list_for_each (
       wlr_subsurface, &surface->current.subsurfaces_above, current.link) {
     struct hikari_view_subsurface *subsurface =
-        (struct hikari_view_subsurface *)hikari_malloc(
+        hikari_pool_alloc(HIKARI_POOL_VIEW_SUBSURFACE,
             sizeof(struct hikari_view_subsurface));
     hikari_view_subsurface_init(subsurface, view, wlr_subsurface);
   }
@@ -863,6 +959,7 @@ hikari_view_map(struct hikari_view *view, struct wlr_surface *surface)
   view->group = group;
 
   wl_list_insert(&sheet->views, &view->sheet_views);
+  link_tileable(view, true);
   wl_list_insert(&group->views, &view->group_views);
   wl_list_insert(&output->views, &view->output_views);
 
@@ -899,7 +996,7 @@ hikari_view_unmap(struct hikari_view *view)
     struct hikari_view_subsurface *subsurface =
         (struct hikari_view_subsurface *)child;
     hikari_view_subsurface_fini(subsurface);
-    hikari_free(subsurface);
+    hikari_pool_free(HIKARI_POOL_VIEW_SUBSURFACE, subsurface);
   }
 
   if (hikari_view_is_forced(view)) {
@@ -943,7 +1040,7 @@ hikari_view_unmap(struct hikari_view *view)
       hikari_tile_detach(tile);
     }
 
-    hikari_free(tile);
+    hikari_pool_free(HIKARI_POOL_TILE, tile);
     view->tile = NULL;
 
     hikari_view_refresh_geometry(view, &geometry);
@@ -951,6 +1048,7 @@ hikari_view_unmap(struct hikari_view *view)
 
   wl_list_remove(&view->sheet_views);
   wl_list_init(&view->sheet_views);
+  unlink_tileable(view);
 
   wl_list_remove(&view->output_views);
   wl_list_init(&view->output_views);
@@ -984,6 +1082,18 @@ hikari_view_show(struct hikari_view *view)
   assert(is_first_view(view));
 }
 
+// hides a view without dropping focus or damaging it, the caller has to take
+// care of both
+void
+hikari_view_conceal(struct hikari_view *view)
+{
+  assert(view != NULL);
+  assert(!hikari_view_is_hidden(view));
+  assert(!hikari_view_is_forced(view));
+
+  hide(view);
+}
+
 void
 hikari_view_hide(struct hikari_view *view)
 {
@@ -1013,18 +1123,12 @@ hikari_view_raise(struct hikari_view *view)
   hikari_view_damage_whole(view);
 }
 
-void
-hikari_view_lower(struct hikari_view *view)
+static void
+lower_view(struct hikari_view *view)
 {
-  assert(view != NULL);
-  assert(!hikari_view_is_hidden(view));
-
-  if (is_last_view(view)) {
-    return;
-  }
-
   wl_list_remove(&view->sheet_views);
   wl_list_insert(view->sheet->views.prev, &view->sheet_views);
+  link_tileable(view, false);
 
   wl_list_remove(&view->group_views);
   wl_list_insert(view->group->views.prev, &view->group_views);
@@ -1044,10 +1148,117 @@ hikari_view_lower(struct hikari_view *view)
 
   wl_list_remove(&view->visible_server_views);
   wl_list_insert(hikari_server.visible_views.prev, &view->visible_server_views);
+}
+
+void
+hikari_view_lower(struct hikari_view *view)
+{
+  assert(view != NULL);
+  assert(!hikari_view_is_hidden(view));
 
+  if (is_last_view(view)) {
+    return;
+  }
+
+  lower_view(view);
   hikari_view_damage_whole(view);
 }
 
+static void
+damage_overlap(pixman_region32_t *damage,
+    struct hikari_view *view,
+    struct hikari_view *other)
+{
+  struct wlr_box overlap;
+
+  if (view->output == other->output &&
+      wlr_box_intersection(&overlap,
+          hikari_view_border_geometry(view),
+          hikari_view_border_geometry(other))) {
+    pixman_region32_union_rect(
+        damage, damage, overlap.x, overlap.y, overlap.width, overlap.height);
+  }
+}
+
+void
+hikari_view_restack(struct hikari_view **views, int nr_of_views, bool raise)
+{
+  assert(views != NULL);
+
+  int nr_of_visible_views = wl_list_length(&hikari_server.visible_views);
+  struct hikari_view **visible_views =
+      hikari_malloc(nr_of_visible_views * sizeof(struct hikari_view *));
+  bool *restacked = hikari_calloc(nr_of_visible_views, sizeof(bool));
+  int *indices = hikari_malloc(nr_of_views * sizeof(int));
+
+  int n = 0;
+  struct hikari_view *view;
+  wl_list_for_each (view, &hikari_server.visible_views, visible_server_views) {
+    visible_views[n++] = view;
+  }
+
+  for (int i = 0; i < nr_of_views; i++) {
+    assert(!hikari_view_is_hidden(views[i]));
+
+    for (n = 0; visible_views[n] != views[i]; n++) {
+      assert(n < nr_of_visible_views);
+    }
+
+    indices[i] = n;
+    restacked[n] = true;
+  }
+
+  // only damage where views change their stacking order relative to each
+  // other, which is where a restacked view overlaps a view it passes
+  struct hikari_output *output;
+  wl_list_for_each (output, &hikari_server.outputs, server_outputs) {
+    pixman_region32_t damage;
+    pixman_region32_init(&damage);
+
+    for (int i = 0; i < nr_of_views; i++) {
+      view = views[i];
+
+      if (view->output != output) {
+        continue;
+      }
+
+      for (int j = i + 1; j < nr_of_views; j++) {
+        if (indices[i] > indices[j]) {
+          damage_overlap(&damage, view, views[j]);
+        }
+      }
+
+      int from = raise ? 0 : indices[i] + 1;
+      int to = raise ? indices[i] : nr_of_visible_views;
+      for (int j = from; j < to; j++) {
+        if (!restacked[j]) {
+          damage_overlap(&damage, view, visible_views[j]);
+        }
+      }
+    }
+
+    if (pixman_region32_not_empty(&damage)) {
+      hikari_output_add_damage_region(output, &damage);
+    }
+
+    pixman_region32_fini(&damage);
+  }
+
+  if (raise) {
+    for (int i = nr_of_views - 1; i >= 0; i--) {
+      raise_view(views[i]);
+    }
+  } else {
+    for (int i = 0; i < nr_of_views; i++) {
+      lower_view(views[i]);
+    }
+  }
+
+  hikari_free(visible_views);
+  hikari_free(restacked);
+  hikari_free(indices);
+}
+
 static void
 commit_tile(struct hikari_view *view, struct hikari_operation *operation)
 {
@@ -1067,7 +1278,7 @@ commit_tile(struct hikari_view *view, struct hikari_operation *operation)
     assert(hikari_tile_is_attached(tile));
 
     wl_list_remove(&tile->layout_tiles);
-    hikari_free(tile);
+    hikari_pool_free(HIKARI_POOL_TILE, tile);
     view->tile = NULL;
   }
 
@@ -1105,6 +1316,8 @@ queue_tile(struct hikari_view *view,
   op->geometry = tile->view_geometry;
   op->center = center;
 
+  hikari_transaction_add(view);
+
   if (current_geometry->width == op->geometry.width &&
       current_geometry->height == op->geometry.height) {
     hikari_view_set_dirty(view);
@@ -1112,20 +1325,28 @@ queue_tile(struct hikari_view *view,
     hikari_view_commit_pending_operation(view, current_geometry);
   } else {
     resize(view, op, commit_tile);
+
+    if (!hikari_view_is_dirty(view)) {
+      hikari_transaction_remove(view);
+    }
   }
 }
 
 void
-hikari_view_tile(
-    struct hikari_view *view, struct wlr_box *geometry, bool center)
+hikari_view_tile(struct hikari_view *view,
+    struct wlr_box *geometry,
+    int container,
+    bool center)
 {
   assert(!hikari_view_is_dirty(view));
   assert(hikari_view_is_tileable(view));
 
   struct hikari_layout *layout = view->sheet->workspace->sheet->layout;
 
-  struct hikari_tile *tile = hikari_malloc(sizeof(struct hikari_tile));
+  struct hikari_tile *tile =
+      hikari_pool_alloc(HIKARI_POOL_TILE, sizeof(struct hikari_tile));
   hikari_tile_init(tile, view, layout, geometry, geometry);
+  tile->container = container;
 
   queue_tile(view, layout, tile, center);
 
@@ -1137,8 +1358,7 @@ commit_full_maximize(
     struct hikari_view *view, struct hikari_operation *operation)
 {
   if (!view->maximized_state) {
-    view->maximized_state =
-        hikari_malloc(sizeof(struct hikari_maximized_state));
+    view->maximized_state = hikari_maximized_state_alloc();
   }
 
   view->maximized_state->maximization = HIKARI_MAXIMIZATION_FULLY_MAXIMIZED;
@@ -1172,7 +1392,7 @@ commit_unmaximize(struct hikari_view *view, struct hikari_operation *operation)
 {
   hikari_view_damage_whole(view);
 
-  hikari_free(view->maximized_state);
+  hikari_maximized_state_destroy(view->maximized_state);
   view->maximized_state = NULL;
 
   if (!view->use_csd) {
@@ -1234,8 +1454,7 @@ commit_horizontal_maximize(
     struct hikari_view *view, struct hikari_operation *operation)
 {
   if (!view->maximized_state) {
-    view->maximized_state =
-        hikari_malloc(sizeof(struct hikari_maximized_state));
+    view->maximized_state = hikari_maximized_state_alloc();
   } else {
     switch (view->maximized_state->maximization) {
       case HIKARI_MAXIMIZATION_HORIZONTALLY_MAXIMIZED:
@@ -1287,8 +1506,7 @@ commit_vertical_maximize(
     struct hikari_view *view, struct hikari_operation *operation)
 {
   if (!view->maximized_state) {
-    view->maximized_state =
-        hikari_malloc(sizeof(struct hikari_maximized_state));
+    view->maximized_state = hikari_maximized_state_alloc();
   } else {
     switch (view->maximized_state->maximization) {
       case HIKARI_MAXIMIZATION_HORIZONTALLY_MAXIMIZED:
@@ -1400,6 +1618,8 @@ hikari_view_toggle_floating(struct hikari_view *view)
   } else {
     hikari_view_unset_floating(view);
   }
+
+  refresh_tileable(view);
 }
 
 void
@@ -1480,10 +1700,10 @@ hikari_view_pin_to_sheet(struct hikari_view *view, struct hikari_sheet *sheet)
 
     view->sheet = sheet;
 
+    move_to_top(view);
+
     if (hikari_view_is_tiled(view)) {
       queue_reset(view, true);
-    } else {
-      move_to_top(view);
     }
   }
 }
@@ -1542,6 +1762,8 @@ hikari_view_toggle_invisible(struct hikari_view *view)
     }
     hikari_view_set_invisible(view);
   }
+
+  refresh_tileable(view);
 }
 
 void
@@ -1584,17 +1806,26 @@ hikari_view_exchange(struct hikari_view *from, struct hikari_view *to)
   struct wlr_box *from_geometry = &from->tile->tile_geometry;
   struct wlr_box *to_geometry = &to->tile->tile_geometry;
 
-  struct hikari_tile *from_tile = hikari_malloc(sizeof(struct hikari_tile));
-  struct hikari_tile *to_tile = hikari_malloc(sizeof(struct hikari_tile));
+  struct hikari_tile *from_tile =
+      hikari_pool_alloc(HIKARI_POOL_TILE, sizeof(struct hikari_tile));
+  struct hikari_tile *to_tile =
+      hikari_pool_alloc(HIKARI_POOL_TILE, sizeof(struct hikari_tile));
 
   hikari_tile_init(from_tile, from, layout, to_geometry, to_geometry);
   hikari_tile_init(to_tile, to, layout, from_geometry, from_geometry);
 
+  from_tile->container = to->tile->container;
+  to_tile->container = from->tile->container;
+
   wl_list_insert(&from->tile->layout_tiles, &to_tile->layout_tiles);
   wl_list_insert(&to->tile->layout_tiles, &from_tile->layout_tiles);
 
+  struct hikari_transaction *transaction = hikari_transaction_begin();
+
   queue_tile(from, layout, from_tile, true);
   queue_tile(to, layout, to_tile, false);
+
+  hikari_transaction_end(transaction);
 }
 
 static void
@@ -1606,7 +1837,7 @@ destroy_subsurface_handler(struct wl_listener *listener, void *data)
 
   hikari_view_subsurface_fini(view_subsurface);
 
-  hikari_free(view_subsurface);
+  hikari_pool_free(HIKARI_POOL_VIEW_SUBSURFACE, view_subsurface);
 }
 
 void
@@ -1686,7 +1917,8 @@ view_subsurface_create(
     struct wlr_subsurface *wlr_subsurface, struct hikari_view *parent)
 {
   struct hikari_view_subsurface *view_subsurface =
-      hikari_malloc(sizeof(struct hikari_view_subsurface));
+      hikari_pool_alloc(HIKARI_POOL_VIEW_SUBSURFACE,
+          sizeof(struct hikari_view_subsurface));
 
   hikari_view_subsurface_init(view_subsurface, parent, wlr_subsurface);
 }
@@ -1807,14 +2039,25 @@ hikari_view_commit_pending_operation(
   assert(view != NULL);
   assert(hikari_view_is_dirty(view));
 
+  if (hikari_transaction_defer(view, geometry)) {
+    return;
+  }
+
   view->pending_operation.geometry.width = geometry->width;
   view->pending_operation.geometry.height = geometry->height;
 
+  // attribute the acknowledged change to the input that requested it
+  bool resumed = hikari_latency_resume(&view->pending_operation.latency);
+
   hikari_indicator_damage(&hikari_server.indicator, view);
   hikari_view_damage_whole(view);
 
   commit_operation(&view->pending_operation, view);
   hikari_view_unset_dirty(view);
+
+  if (resumed) {
+    hikari_latency_suspend();
+  }
 }
 
 void
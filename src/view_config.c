@@ -52,11 +52,11 @@ hikari_view_config_fini(struct hikari_view_config *view_config)
 
   if (child_properties != properties) {
     fini_properties(child_properties);
-    hikari_free(child_properties);
+    hikari_tagged_free(child_properties);
   }
 
   fini_properties(properties);
-  hikari_free(view_config->app_id);
+  hikari_tagged_free(view_config->app_id);
 }
 
 struct hikari_sheet *
@@ -371,8 +371,8 @@ hikari_view_config_parse(
       ucl_object_lookup(view_config_obj, "inherit");
 
   if (inherit_obj != NULL) {
-    view_config->child_properties =
-        hikari_malloc(sizeof(struct hikari_view_properties));
+    view_config->child_properties = hikari_tagged_malloc(
+        HIKARI_MEMORY_CONFIGURATION, sizeof(struct hikari_view_properties));
 
     struct hikari_view_properties *child_properties =
         view_config->child_properties;
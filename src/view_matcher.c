@@ -0,0 +1,214 @@
+#include <hikari/view_matcher.h>
+
+#include <fnmatch.h>
+#include <regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hikari/log.h>
+#include <hikari/memory.h>
+#include <hikari/view_config.h>
+
+#define MAX_MATCHES 256
+
+enum view_pattern_type { VIEW_PATTERN_GLOB, VIEW_PATTERN_REGEX };
+
+struct view_pattern {
+  enum view_pattern_type type;
+  struct hikari_view_config *view_config;
+
+  regex_t regex;
+};
+
+struct view_match {
+  struct hikari_hash_map_entry entry;
+
+  char *app_id;
+  struct hikari_view_config *view_config;
+};
+
+void
+hikari_view_matcher_init(struct hikari_view_matcher *view_matcher)
+{
+  hikari_hash_map_init(&view_matcher->exact);
+  hikari_hash_map_init(&view_matcher->cache);
+
+  view_matcher->patterns = NULL;
+  view_matcher->nr_of_patterns = 0;
+  view_matcher->matches = NULL;
+  view_matcher->nr_of_matches = 0;
+}
+
+static void
+clear_matches(struct hikari_view_matcher *view_matcher)
+{
+  for (int i = 0; i < view_matcher->nr_of_matches; i++) {
+    struct view_match *match = view_matcher->matches[i];
+
+    hikari_free(match->app_id);
+    hikari_free(match);
+  }
+
+  hikari_hash_map_fini(&view_matcher->cache);
+  view_matcher->nr_of_matches = 0;
+}
+
+void
+hikari_view_matcher_fini(struct hikari_view_matcher *view_matcher)
+{
+  for (int i = 0; i < view_matcher->nr_of_patterns; i++) {
+    struct view_pattern *pattern = &view_matcher->patterns[i];
+
+    if (pattern->type == VIEW_PATTERN_REGEX) {
+      regfree(&pattern->regex);
+    }
+  }
+
+  clear_matches(view_matcher);
+
+  hikari_hash_map_fini(&view_matcher->exact);
+  hikari_free(view_matcher->patterns);
+  hikari_free(view_matcher->matches);
+}
+
+static bool
+is_regex(const char *app_id, size_t len)
+{
+  return len > 2 && app_id[0] == '/' && app_id[len - 1] == '/';
+}
+
+static bool
+is_glob(const char *app_id)
+{
+  return strpbrk(app_id, "*?[") != NULL;
+}
+
+static bool
+compile_regex(struct view_pattern *pattern, const char *app_id, size_t len)
+{
+  char *source = strndup(app_id + 1, len - 2);
+  int error = regcomp(&pattern->regex, source, REG_EXTENDED | REG_NOSUB);
+
+  hikari_free(source);
+
+  if (error != 0) {
+    char message[256];
+    regerror(error, &pattern->regex, message, sizeof(message));
+
+    hikari_log_error(
+        "configuration error: invalid regular expression %s: %s",
+        app_id,
+        message);
+
+    return false;
+  }
+
+  return true;
+}
+
+bool
+hikari_view_matcher_add(struct hikari_view_matcher *view_matcher,
+    struct hikari_view_config *view_config)
+{
+  const char *app_id = view_config->app_id;
+  size_t len = strlen(app_id);
+  struct view_pattern pattern = { .view_config = view_config };
+
+  if (is_regex(app_id, len)) {
+    pattern.type = VIEW_PATTERN_REGEX;
+
+    if (!compile_regex(&pattern, app_id, len)) {
+      return false;
+    }
+  } else if (is_glob(app_id)) {
+    pattern.type = VIEW_PATTERN_GLOB;
+  } else {
+    hikari_hash_map_insert(
+        &view_matcher->exact, &view_config->matcher_entry, app_id);
+
+    return true;
+  }
+
+  view_matcher->patterns = hikari_realloc(view_matcher->patterns,
+      (view_matcher->nr_of_patterns + 1) * sizeof(struct view_pattern));
+  view_matcher->patterns[view_matcher->nr_of_patterns++] = pattern;
+
+  return true;
+}
+
+static bool
+pattern_matches(struct view_pattern *pattern, const char *app_id)
+{
+  switch (pattern->type) {
+    case VIEW_PATTERN_GLOB:
+      return fnmatch(pattern->view_config->app_id, app_id, 0) == 0;
+
+    case VIEW_PATTERN_REGEX:
+      return regexec(&pattern->regex, app_id, 0, NULL, 0) == 0;
+  }
+
+  return false;
+}
+
+static struct hikari_view_config *
+resolve(struct hikari_view_matcher *view_matcher, const char *app_id)
+{
+  struct hikari_hash_map_entry *entry =
+      hikari_hash_map_lookup(&view_matcher->exact, app_id);
+
+  if (entry != NULL) {
+    struct hikari_view_config *view_config =
+        wl_container_of(entry, view_config, matcher_entry);
+
+    return view_config;
+  }
+
+  enum view_pattern_type types[] = { VIEW_PATTERN_GLOB, VIEW_PATTERN_REGEX };
+
+  for (int i = 0; i < 2; i++) {
+    for (int n = 0; n < view_matcher->nr_of_patterns; n++) {
+      struct view_pattern *pattern = &view_matcher->patterns[n];
+
+      if (pattern->type == types[i] && pattern_matches(pattern, app_id)) {
+        return pattern->view_config;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+struct hikari_view_config *
+hikari_view_matcher_match(
+    struct hikari_view_matcher *view_matcher, const char *app_id)
+{
+  if (view_matcher->nr_of_patterns == 0) {
+    return resolve(view_matcher, app_id);
+  }
+
+  struct hikari_hash_map_entry *entry =
+      hikari_hash_map_lookup(&view_matcher->cache, app_id);
+
+  if (entry != NULL) {
+    struct view_match *match = wl_container_of(entry, match, entry);
+
+    return match->view_config;
+  }
+
+  if (view_matcher->nr_of_matches == MAX_MATCHES) {
+    clear_matches(view_matcher);
+  } else if (view_matcher->matches == NULL) {
+    view_matcher->matches =
+        hikari_malloc(MAX_MATCHES * sizeof(struct view_match *));
+  }
+
+  struct view_match *match = hikari_malloc(sizeof(struct view_match));
+
+  match->app_id = strdup(app_id);
+  match->view_config = resolve(view_matcher, app_id);
+
+  hikari_hash_map_insert(&view_matcher->cache, &match->entry, match->app_id);
+  view_matcher->matches[view_matcher->nr_of_matches++] = match;
+
+  return match->view_config;
+}
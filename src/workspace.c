@@ -16,6 +16,7 @@
 #include <hikari/indicator.h>
 #include <hikari/indicator_frame.h>
 #include <hikari/input_grab_mode.h>
+#include <hikari/latency.h>
 #include <hikari/layout.h>
 #include <hikari/log.h>
 #include <hikari/mark_assign_mode.h>
@@ -148,7 +149,25 @@ hikari_workspace_clear(struct hikari_workspace *workspace)
 static void
 display_sheet(struct hikari_workspace *workspace, struct hikari_sheet *sheet)
 {
-  hikari_workspace_clear(workspace);
+  struct hikari_output *output = workspace->output;
+  struct hikari_view *focus_view = workspace->focus_view;
+
+  // only drop focus if the focus view does not get shown again
+  if (focus_view != NULL && !hikari_view_is_hidden(focus_view) &&
+      (hikari_view_is_invisible(focus_view) ||
+          (focus_view->sheet->nr != 0 && focus_view->sheet != sheet))) {
+    hikari_view_hide(focus_view);
+  }
+
+  // views get hidden and shown without damaging each of them, the output is
+  // damaged once the sheet is displayed
+  output->damage_suspended = true;
+
+  struct hikari_view *view, *view_tmp;
+  wl_list_for_each_reverse_safe (
+      view, view_tmp, &workspace->views, workspace_views) {
+    hikari_view_conceal(view);
+  }
 
   if (sheet != workspace->sheet) {
     workspace->alternate_sheet = workspace->sheet;
@@ -161,6 +180,12 @@ display_sheet(struct hikari_workspace *workspace, struct hikari_sheet *sheet)
     hikari_sheet_show(sheet);
   }
 
+  output->damage_suspended = false;
+
+  if (output->enabled) {
+    hikari_output_damage_whole(output);
+  }
+
   hikari_server_cursor_focus();
 }
 
@@ -366,12 +391,15 @@ CYCLE_GROUP(next, prev)
 CYCLE_GROUP(prev, next)
 #undef CYCLE_GROUP
 
-void
-hikari_workspace_focus_view(
-    struct hikari_workspace *workspace, struct hikari_view *view)
+static void
+set_focus_view(struct hikari_workspace *workspace,
+    struct hikari_view *view,
+    bool defer)
 {
   assert(hikari_server_in_normal_mode());
 
+  hikari_latency_mark(HIKARI_LATENCY_FOCUS);
+
   struct wlr_seat *seat = hikari_server.seat;
 
   struct hikari_workspace *current_workspace = hikari_server.workspace;
@@ -384,7 +412,11 @@ hikari_workspace_focus_view(
     } else {
       hikari_view_damage_border(focus_view);
     }
-    hikari_view_activate(focus_view, false);
+
+    // a deferred focus view has never been activated
+    if (!hikari_server.focus_deferred) {
+      hikari_view_activate(focus_view, false);
+    }
   }
 
   wlr_seat_keyboard_end_grab(seat);
@@ -398,16 +430,18 @@ hikari_workspace_focus_view(
   if (view != NULL) {
     assert(!hikari_view_is_hidden(view));
 
-    struct wlr_keyboard *wlr_keyboard = wlr_seat_get_keyboard(seat);
+    if (!defer) {
+      struct wlr_keyboard *wlr_keyboard = wlr_seat_get_keyboard(seat);
 
-    hikari_view_activate(view, true);
+      hikari_view_activate(view, true);
 
-    if (wlr_keyboard != NULL) {
-      wlr_seat_keyboard_notify_enter(seat,
-          view->surface,
-          wlr_keyboard->keycodes,
-          wlr_keyboard->num_keycodes,
-          &wlr_keyboard->modifiers);
+      if (wlr_keyboard != NULL) {
+        wlr_seat_keyboard_notify_enter(seat,
+            view->surface,
+            wlr_keyboard->keycodes,
+            wlr_keyboard->num_keycodes,
+            &wlr_keyboard->modifiers);
+      }
     }
 
     if (hikari_server_is_indicating()) {
@@ -424,9 +458,29 @@ hikari_workspace_focus_view(
   }
 
   hikari_server.workspace = workspace;
+  hikari_server.focus_deferred = defer && view != NULL;
   workspace->focus_view = view;
 }
 
+void
+hikari_workspace_focus_view(
+    struct hikari_workspace *workspace, struct hikari_view *view)
+{
+  // while cycling with a held modifier only the indicator follows the
+  // selection, clients are activated once the modifier is released
+  bool defer = hikari_server_is_cycling() && hikari_server_is_indicating();
+
+  set_focus_view(workspace, view, defer);
+}
+
+void
+hikari_workspace_commit_focus(struct hikari_workspace *workspace)
+{
+  if (hikari_server.focus_deferred) {
+    set_focus_view(workspace, workspace->focus_view, false);
+  }
+}
+
 void
 hikari_workspace_raise_view(struct hikari_workspace *workspace)
 {
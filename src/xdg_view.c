@@ -14,9 +14,11 @@
 #include <wlr/util/edges.h>
 
 #include <hikari/configuration.h>
+#include <hikari/decoration.h>
 #include <hikari/geometry.h>
 #include <hikari/log.h>
 #include <hikari/mark.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
@@ -52,14 +54,9 @@ commit_handler(struct wl_listener *listener, void *data)
   struct wlr_xdg_surface *surface = xdg_view->surface;
 
   if (surface->initial_commit) {
-    struct wlr_xdg_toplevel_decoration_v1 *dec;
-    wl_list_for_each(dec,
-        &hikari_server.xdg_decoration_manager->decorations, link) {
-      if (dec->toplevel == surface->toplevel) {
-        wlr_xdg_toplevel_decoration_v1_set_mode(
-            dec, WLR_XDG_TOPLEVEL_DECORATION_V1_MODE_SERVER_SIDE);
-        break;
-      }
+    if (xdg_view->decoration != NULL) {
+      wlr_xdg_toplevel_decoration_v1_set_mode(xdg_view->decoration->decoration,
+          WLR_XDG_TOPLEVEL_DECORATION_V1_MODE_SERVER_SIDE);
     }
     wlr_xdg_toplevel_set_size(surface->toplevel, 0, 0);
     wlr_xdg_surface_schedule_configure(surface);
@@ -307,8 +304,12 @@ destroy_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&xdg_view->destroy.link);
   wl_list_remove(&xdg_view->commit.link);
 
+  if (xdg_view->decoration != NULL) {
+    xdg_view->decoration->xdg_view = NULL;
+  }
+
   hikari_view_fini(view);
-  hikari_free(xdg_view);
+  hikari_pool_free(HIKARI_POOL_XDG_VIEW, xdg_view);
 }
 
 static void
@@ -343,7 +344,7 @@ destroy_popup_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&popup->map.link);
   wl_list_remove(&popup->new_popup.link);
 
-  hikari_free(popup);
+  hikari_pool_free(HIKARI_POOL_XDG_POPUP, popup);
 }
 
 static void
@@ -423,7 +424,7 @@ static void
 xdg_popup_create(struct wlr_xdg_popup *wlr_popup, struct hikari_view *parent)
 {
   struct hikari_xdg_popup *popup =
-      hikari_malloc(sizeof(struct hikari_xdg_popup));
+      hikari_pool_alloc(HIKARI_POOL_XDG_POPUP, sizeof(struct hikari_xdg_popup));
 
   hikari_log_trace("CREATE POPUP");
 
@@ -499,6 +500,7 @@ hikari_xdg_view_init(struct hikari_xdg_view *xdg_view,
 
   xdg_view->surface = xdg_surface;
   xdg_view->surface->data = xdg_view;
+  xdg_view->decoration = NULL;
 
   xdg_view->map.notify = map_handler;
   wl_signal_add(&xdg_surface->surface->events.map, &xdg_view->map);
@@ -159,7 +159,8 @@ destroy_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&xwayland_unmanaged_view->destroy.link);
   wl_list_remove(&xwayland_unmanaged_view->request_configure.link);
 
-  hikari_free(xwayland_unmanaged_view);
+  hikari_pool_free(
+      HIKARI_POOL_XWAYLAND_UNMANAGED_VIEW, xwayland_unmanaged_view);
 }
 
 static void
@@ -10,6 +10,7 @@
 #include <hikari/configuration.h>
 #include <hikari/geometry.h>
 #include <hikari/log.h>
+#include <hikari/memory.h>
 #include <hikari/output.h>
 #include <hikari/server.h>
 #include <hikari/sheet.h>
@@ -290,7 +291,7 @@ destroy_handler(struct wl_listener *listener, void *data)
   wl_list_remove(&xwayland_view->request_configure.link);
   wl_list_remove(&xwayland_view->set_title.link);
 
-  hikari_free(xwayland_view);
+  hikari_pool_free(HIKARI_POOL_XWAYLAND_VIEW, xwayland_view);
 }
 
 static void